@@ -0,0 +1,351 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "box2d.hpp"
+#include "point2d.hpp"
+#include "random.hpp"
+#include "ray.hpp"
+
+///
+/// Baseline numbers of the geometry primitives.
+///
+/// Every benchmark runs over a fixed set of random inputs
+/// of one distribution, so hit rates and branches are stable
+/// between runs. Results are written to geometry_bench.json
+/// unless --benchmark_out is given.
+///
+/// Usage: SpaceInvaders_bench [google benchmark flags]
+///
+
+namespace
+{
+
+/// Inputs of one run. It is a power of two to wrap the index with a mask.
+size_t constexpr kInputs = 4096;
+
+/// Side of the game field.
+float constexpr kField = 1024.0f;
+
+enum Distribution
+{
+  // Boxes and points are spread over the field.
+  Uniform,
+  // Everything is packed into a small area, most checks hit.
+  Clustered,
+  // Boxes lie on a grid with gaps, most checks miss.
+  Disjoint,
+  // Points and directions lie on the axes, it hits special cases.
+  AxisAligned
+};
+
+char const * GetName(Distribution distribution)
+{
+  switch (distribution)
+  {
+    case Uniform: return "uniform";
+    case Clustered: return "clustered";
+    case Disjoint: return "disjoint";
+    case AxisAligned: return "axis_aligned";
+  }
+  return "";
+}
+
+Point2D RandomPoint(Pcg32 & random, Distribution distribution)
+{
+  switch (distribution)
+  {
+    case Clustered:
+      return { random.NextFloat(500.0f, 540.0f), random.NextFloat(500.0f, 540.0f) };
+    case Disjoint:
+      // Cells of 64 pixels, the point stays in the lower half of a cell.
+      return { 64.0f * (random.Next() % 16) + random.NextFloat(0.0f, 16.0f),
+               64.0f * (random.Next() % 16) + random.NextFloat(0.0f, 16.0f) };
+    case AxisAligned:
+      return random.Next() % 2 == 0
+          ? Point2D(random.NextFloat(-kField, kField), 0.0f)
+          : Point2D(0.0f, random.NextFloat(-kField, kField));
+    case Uniform:
+    default:
+      return { random.NextFloat(0.0f, kField), random.NextFloat(0.0f, kField) };
+  }
+}
+
+Box2D RandomBox(Pcg32 & random, Distribution distribution)
+{
+  Point2D const minPoint = RandomPoint(random, distribution);
+  float const size = distribution == Disjoint ? 16.0f : random.NextFloat(8.0f, 64.0f);
+
+  return Box2D::createBox(minPoint, minPoint + Point2D(size, size));
+}
+
+Distribution GetDistribution(benchmark::State & state)
+{
+  Distribution const distribution = static_cast<Distribution>(state.range(0));
+  state.SetLabel(GetName(distribution));
+  return distribution;
+}
+
+template<typename T, typename TGenerator>
+std::vector<T> Generate(Distribution distribution, TGenerator generator)
+{
+  Pcg32 random(static_cast<uint64_t>(distribution) + 1, 0);
+
+  std::vector<T> values;
+  values.reserve(kInputs);
+
+  for (size_t i = 0; i < kInputs; ++i)
+  {
+    values.push_back(generator(random));
+  }
+
+  return values;
+}
+
+std::vector<Point2D> GeneratePoints(Distribution distribution)
+{
+  return Generate<Point2D>(distribution, [distribution](Pcg32 & random)
+  {
+    return RandomPoint(random, distribution);
+  });
+}
+
+std::vector<Box2D> GenerateBoxes(Distribution distribution)
+{
+  return Generate<Box2D>(distribution, [distribution](Pcg32 & random)
+  {
+    return RandomBox(random, distribution);
+  });
+}
+
+std::vector<Ray> GenerateRays(Distribution distribution)
+{
+  return Generate<Ray>(distribution, [distribution](Pcg32 & random)
+  {
+    Point2D direction = RandomPoint(random, distribution == AxisAligned ? AxisAligned : Uniform);
+    return Ray(RandomPoint(random, distribution),
+               direction - Point2D(0.5f * kField, 0.5f * kField));
+  });
+}
+
+void BM_CreateBox(benchmark::State & state)
+{
+  auto const points = GeneratePoints(GetDistribution(state));
+  size_t i = 0;
+
+  for (auto _ : state)
+  {
+    Point2D const & first = points[i & (kInputs - 1)];
+    Point2D const & second = points[(i + 1) & (kInputs - 1)];
+    benchmark::DoNotOptimize(Box2D::createBox(Point2D(std::min(first.x(), second.x()),
+                                                      std::min(first.y(), second.y())),
+                                              Point2D(std::max(first.x(), second.x()) + 1.0f,
+                                                      std::max(first.y(), second.y()) + 1.0f)));
+    ++i;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_CheckBoxes(benchmark::State & state)
+{
+  auto const boxes = GenerateBoxes(GetDistribution(state));
+  size_t i = 0;
+  size_t hits = 0;
+
+  for (auto _ : state)
+  {
+    bool const hit = Box2D::checkBoxes(boxes[i & (kInputs - 1)],
+                                       boxes[(i * 7 + 1) & (kInputs - 1)]);
+    benchmark::DoNotOptimize(hit);
+    hits += hit;
+    ++i;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.counters["hit_rate"] = static_cast<double>(hits) / std::max<size_t>(i, 1);
+}
+
+void BM_CheckInside(benchmark::State & state)
+{
+  Distribution const distribution = GetDistribution(state);
+  auto const boxes = GenerateBoxes(distribution);
+  auto const points = GeneratePoints(distribution);
+  size_t i = 0;
+  size_t hits = 0;
+
+  for (auto _ : state)
+  {
+    bool const hit = Box2D::checkInside(boxes[i & (kInputs - 1)],
+                                        points[(i * 7 + 1) & (kInputs - 1)]);
+    benchmark::DoNotOptimize(hit);
+    hits += hit;
+    ++i;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.counters["hit_rate"] = static_cast<double>(hits) / std::max<size_t>(i, 1);
+}
+
+void BM_RayCheckIntersection(benchmark::State & state)
+{
+  Distribution const distribution = GetDistribution(state);
+  auto const rays = GenerateRays(distribution);
+  auto const boxes = GenerateBoxes(distribution);
+  size_t i = 0;
+  size_t hits = 0;
+
+  for (auto _ : state)
+  {
+    bool const hit = Ray::checkIntersection(rays[i & (kInputs - 1)],
+                                            boxes[(i * 7 + 1) & (kInputs - 1)]);
+    benchmark::DoNotOptimize(hit);
+    hits += hit;
+    ++i;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  state.counters["hit_rate"] = static_cast<double>(hits) / std::max<size_t>(i, 1);
+}
+
+void BM_RayIntersectBatch(benchmark::State & state)
+{
+  Distribution const distribution = GetDistribution(state);
+  auto const rays = GenerateRays(distribution);
+  auto const boxes = GenerateBoxes(distribution);
+  std::vector<float> entries(boxes.size());
+  size_t i = 0;
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(Ray::intersect(rays[i & (kInputs - 1)], boxes.data(),
+                                            boxes.size(), entries.data()));
+    ++i;
+  }
+
+  state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+
+void BM_RayNormalize(benchmark::State & state)
+{
+  auto const points = GeneratePoints(GetDistribution(state));
+  size_t i = 0;
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(Ray::normalize(points[i & (kInputs - 1)]));
+    ++i;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Point2DArithmetic(benchmark::State & state)
+{
+  auto const points = GeneratePoints(GetDistribution(state));
+  size_t i = 0;
+
+  for (auto _ : state)
+  {
+    Point2D const & a = points[i & (kInputs - 1)];
+    Point2D const & b = points[(i + 1) & (kInputs - 1)];
+
+    Point2D result = (a + b) * 0.5f - b / 4.0f;
+    result += a;
+    result -= -b;
+    benchmark::DoNotOptimize(result);
+    ++i;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Point2DCompare(benchmark::State & state)
+{
+  auto const points = GeneratePoints(GetDistribution(state));
+  size_t i = 0;
+
+  for (auto _ : state)
+  {
+    Point2D const & a = points[i & (kInputs - 1)];
+    Point2D const & b = points[(i + 1) & (kInputs - 1)];
+
+    benchmark::DoNotOptimize(a == b);
+    benchmark::DoNotOptimize(a < b);
+    ++i;
+  }
+
+  state.SetItemsProcessed(2 * state.iterations());
+}
+
+void BM_Point2DHash(benchmark::State & state)
+{
+  auto const points = GeneratePoints(GetDistribution(state));
+  Point2D::Hash const hasher;
+  size_t i = 0;
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(hasher(points[i & (kInputs - 1)]));
+    ++i;
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+void AllDistributions(benchmark::internal::Benchmark * benchmark)
+{
+  benchmark->ArgName("distribution");
+
+  for (int distribution = Uniform; distribution <= AxisAligned; ++distribution)
+  {
+    benchmark->Arg(distribution);
+  }
+}
+
+} // namespace
+
+BENCHMARK(BM_CreateBox)->Apply(AllDistributions);
+BENCHMARK(BM_CheckBoxes)->Apply(AllDistributions);
+BENCHMARK(BM_CheckInside)->Apply(AllDistributions);
+BENCHMARK(BM_RayCheckIntersection)->Apply(AllDistributions);
+BENCHMARK(BM_RayIntersectBatch)->Apply(AllDistributions);
+BENCHMARK(BM_RayNormalize)->Apply(AllDistributions);
+BENCHMARK(BM_Point2DArithmetic)->Apply(AllDistributions);
+BENCHMARK(BM_Point2DCompare)->Apply(AllDistributions);
+BENCHMARK(BM_Point2DHash)->Apply(AllDistributions);
+
+int main(int argc, char ** argv)
+{
+  std::vector<char *> arguments(argv, argv + argc);
+
+  bool hasOutput = false;
+  for (int i = 1; i < argc; ++i)
+  {
+    hasOutput = hasOutput || std::strncmp(argv[i], "--benchmark_out=", 16) == 0;
+  }
+
+  // Keep the JSON report for regression tracking by default.
+  std::string output = "--benchmark_out=geometry_bench.json";
+  std::string format = "--benchmark_out_format=json";
+  if (!hasOutput)
+  {
+    arguments.push_back(&output[0]);
+    arguments.push_back(&format[0]);
+  }
+
+  int count = static_cast<int>(arguments.size());
+  benchmark::Initialize(&count, arguments.data());
+
+  if (benchmark::ReportUnrecognizedArguments(count, arguments.data()))
+  {
+    return 1;
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+#include <QCoreApplication>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "batch_environment.hpp"
+#include "settings.hpp"
+#include "images.hpp"
+#include "random.hpp"
+
+///
+/// Throughput of independent games for a growing number of threads.
+///
+/// Usage: SpaceInvaders_scaling [games] [steps]
+///
+int main(int argc, char ** argv)
+{
+  QCoreApplication a(argc, argv);
+
+  size_t const games = argc > 1 ? std::stoul(argv[1]) : 256;
+  size_t const steps = argc > 2 ? std::stoul(argv[2]) : 2000;
+
+  try
+  {
+    Images::Instance().LoadImages();
+
+    Settings::Instance().LoadMainSettings();
+    Settings::Instance().LoadLevelSettings("1");
+  }
+  catch (std::exception const & ex)
+  {
+    std::cerr << ex.what() << std::endl;
+
+    return 1;
+  }
+
+  size_t const cores = std::max(1u, std::thread::hardware_concurrency());
+
+  std::vector<size_t> threadCounts;
+  for (size_t threads = 1; threads < cores; threads *= 2)
+  {
+    threadCounts.push_back(threads);
+  }
+  threadCounts.push_back(cores);
+
+  std::cout << "Games: " << games << ", steps: " << steps
+            << ", cores: " << cores << std::endl
+            << std::setw(8) << "threads"
+            << std::setw(16) << "ticks/s"
+            << std::setw(10) << "speedup"
+            << std::setw(12) << "efficiency" << std::endl;
+
+  double baseline = 0.0;
+
+  for (auto threads : threadCounts)
+  {
+    BatchEnvironment environment(games, 1, 1, threads);
+
+    // The same actions for every run.
+    Pcg32 random;
+    random.Seed(1, 0);
+
+    std::vector<BatchAction> actions(games);
+
+    auto const start = std::chrono::steady_clock::now();
+
+    for (size_t step = 0; step < steps; ++step)
+    {
+      for (auto & action : actions)
+      {
+        action = static_cast<BatchAction>(random.Next() % static_cast<uint32_t>(BatchAction::Count));
+      }
+
+      environment.Step(actions.data());
+    }
+
+    auto const finish = std::chrono::steady_clock::now();
+
+    double const seconds = std::chrono::duration<double>(finish - start).count();
+    double const ticksPerSecond = static_cast<double>(games) * steps / seconds;
+
+    if (baseline == 0.0)
+    {
+      baseline = ticksPerSecond;
+    }
+
+    double const speedup = ticksPerSecond / baseline;
+
+    std::cout << std::setw(8) << threads
+              << std::setw(16) << std::fixed << std::setprecision(0) << ticksPerSecond
+              << std::setw(10) << std::setprecision(2) << speedup
+              << std::setw(11) << std::setprecision(0) << 100.0 * speedup / threads << "%"
+              << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,256 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#include "world.hpp"
+#include "random.hpp"
+
+///
+/// Cost of the game logic for growing populations.
+///
+/// A scenario builds the world directly from parameters, so no
+/// settings file is needed. It spawns bullets in flight and explosions
+/// over the field, then runs the tick headless for a fixed number
+/// of steps. Aliens, obstacles and the space ship are too strong to die,
+/// so the population stays close to the scenario size.
+///
+/// Counters:
+///   time_per_tick - wall time of one tick;
+///   allocs_per_tick - calls of operator new per tick;
+///   pairs_per_tick - box pairs tested by the collision passes per tick;
+///   arena_kb - the most memory of the frame arena in one tick.
+///
+/// BM_Hash measures the state hash which every tick adds to the history,
+/// it must stay flat across the scenarios.
+///
+/// Usage: SpaceInvaders_stress [google benchmark flags]
+///
+
+namespace
+{
+
+std::atomic<uint64_t> g_allocations(0);
+
+/// Ticks of one benchmark iteration.
+int constexpr kSteps = 20;
+
+struct Scenario
+{
+  char const * m_name;
+  // Aliens make a grid of m_aliensNumber x m_alienRowNumber.
+  size_t m_aliensNumber;
+  size_t m_alienRowNumber;
+  size_t m_obstacles;
+  size_t m_bullets;
+  size_t m_explosions;
+};
+
+Scenario const kScenarios[] =
+{
+  // The shipped levels.
+  { "level1", 8, 2, 8, 0, 0 },
+  { "level3", 12, 4, 12, 0, 0 },
+  // Custom levels, about 1k, 10k and 100k entities.
+  { "1k", 40, 15, 40, 300, 60 },
+  { "10k", 200, 30, 200, 3000, 800 },
+  { "100k", 600, 100, 1000, 30000, 9000 }
+};
+
+GameContext MakeContext(Scenario const & scenario)
+{
+  GameContext context;
+  context.m_fieldSize = QSize(1920, 1080);
+
+  GameParameters & parameters = context.m_parameters;
+  parameters.m_mainParameters.m_seed = 1;
+  // The whole formation appears on the first step.
+  parameters.m_mainParameters.m_spawnBudget = std::numeric_limits<uint>::max();
+  // The explosions of the scenario and of the hits fit together.
+  parameters.m_mainParameters.m_particleCapacity = 4096 + scenario.m_explosions;
+
+  parameters.m_starParameters.m_number = 100;
+  parameters.m_starParameters.m_size = { 16, 16 };
+
+  parameters.m_explosionParameters.m_size = { 16, 16 };
+  parameters.m_explosionParameters.m_sizeBig = { 64, 64 };
+  parameters.m_explosionParameters.m_lifetime = 30;
+  parameters.m_explosionParameters.m_lifetimeBig = 60;
+  parameters.m_explosionParameters.m_particles = 8;
+  parameters.m_explosionParameters.m_speed = 120.0f;
+
+  parameters.m_alienParameters.m_number = scenario.m_aliensNumber;
+  parameters.m_alienParameters.m_rowNumber = scenario.m_alienRowNumber;
+  parameters.m_alienParameters.m_speed = 100;
+  parameters.m_alienParameters.m_rate = 1000;
+  parameters.m_alienParameters.m_health = 1 << 30;
+  parameters.m_alienParameters.m_size = { 64, 64 };
+  parameters.m_alienParameters.m_frequency = 50;
+  parameters.m_alienParameters.m_score = 10;
+
+  parameters.m_bulletParameters.m_damage = 100;
+  parameters.m_bulletParameters.m_size = { 32, 32 };
+
+  parameters.m_spaceShipParameters.m_health = 1 << 30;
+  parameters.m_spaceShipParameters.m_rate = 2000;
+  parameters.m_spaceShipParameters.m_speed = 2000;
+  parameters.m_spaceShipParameters.m_size = { 128, 128 };
+
+  parameters.m_obstacleParameters.m_number = scenario.m_obstacles;
+  parameters.m_obstacleParameters.m_health = 1 << 30;
+  parameters.m_obstacleParameters.m_size = { 64, 64 };
+  parameters.m_obstacleParameters.m_score = 5;
+
+  return context;
+}
+
+void Populate(World & world, GameContext const & context, Scenario const & scenario)
+{
+  Space & space = *world.GetSpace();
+  Pcg32 random(context.m_parameters.m_mainParameters.m_seed, 0);
+
+  float const width = context.m_fieldSize.width();
+  float const height = context.m_fieldSize.height();
+  BulletParameters const & bullet = context.m_parameters.m_bulletParameters;
+
+  for (size_t i = 0; i < scenario.m_bullets; ++i)
+  {
+    QVector2D const position(random.NextFloat(0.0f, width), random.NextFloat(0.0f, height));
+
+    if (i % 2 == 0)
+    {
+      space.SpawnSpaceShipBullet(Bullet(position, bullet.m_damage, bullet.m_size));
+    }
+    else
+    {
+      space.SpawnAlienBullet(Bullet(position, bullet.m_damage, bullet.m_size));
+    }
+  }
+
+  // Explosions live through the whole run.
+  for (size_t i = 0; i < scenario.m_explosions; ++i)
+  {
+    world.GetParticles().Emit(QVector2D(random.NextFloat(0.0f, width), random.NextFloat(0.0f, height)),
+                              QVector2D(),
+                              (kSteps + 1) * World::kFixedTimeStep,
+                              context.m_parameters.m_explosionParameters.m_sizeBig);
+  }
+}
+
+size_t CountEntities(World const & world)
+{
+  Space & space = *world.GetSpace();
+
+  return 1 + space.GetAliens().size() + space.GetObstacles().size() +
+         space.GetSpaceShipBullets().size() + space.GetAlienBullets().size() +
+         world.GetParticles().GetCount();
+}
+
+void BM_Tick(benchmark::State & state)
+{
+  Scenario const & scenario = kScenarios[state.range(0)];
+  GameContext const context = MakeContext(scenario);
+
+  state.SetLabel(scenario.m_name);
+
+  uint64_t ticks = 0;
+  uint64_t allocations = 0;
+  uint64_t pairs = 0;
+  size_t entities = 0;
+  size_t arenaPeak = 0;
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    World world(context, 1);
+    world.Initialize();
+    world.Tick(World::kFixedTimeStep);
+    Populate(world, context, scenario);
+    entities = CountEntities(world);
+    uint64_t const allocationsBefore = g_allocations.load();
+    uint64_t const pairsBefore = world.GetCollisionTests();
+    state.ResumeTiming();
+
+    for (int i = 0; i < kSteps; ++i)
+    {
+      world.Tick(World::kFixedTimeStep);
+    }
+
+    state.PauseTiming();
+    allocations += g_allocations.load() - allocationsBefore;
+    pairs += world.GetCollisionTests() - pairsBefore;
+    arenaPeak = std::max(arenaPeak, world.GetFrameArena().GetPeak());
+    ticks += kSteps;
+    state.ResumeTiming();
+  }
+
+  state.counters["entities"] = entities;
+  state.counters["time_per_tick"] = benchmark::Counter(ticks, benchmark::Counter::kIsRate |
+                                                              benchmark::Counter::kInvert);
+  state.counters["allocs_per_tick"] = static_cast<double>(allocations) / ticks;
+  state.counters["pairs_per_tick"] = static_cast<double>(pairs) / ticks;
+  state.counters["arena_kb"] = arenaPeak / 1024.0;
+}
+
+void BM_Hash(benchmark::State & state)
+{
+  Scenario const & scenario = kScenarios[state.range(0)];
+  GameContext const context = MakeContext(scenario);
+
+  state.SetLabel(scenario.m_name);
+
+  World world(context, 1);
+  world.Initialize();
+  world.Tick(World::kFixedTimeStep);
+  Populate(world, context, scenario);
+  world.Tick(World::kFixedTimeStep);
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(world.Hash());
+  }
+
+  state.counters["entities"] = CountEntities(world);
+}
+
+void AllScenarios(benchmark::internal::Benchmark * benchmark)
+{
+  benchmark->ArgName("scenario");
+
+  for (size_t i = 0; i < sizeof(kScenarios) / sizeof(kScenarios[0]); ++i)
+  {
+    benchmark->Arg(static_cast<int>(i));
+  }
+}
+
+} // namespace
+
+void * operator new(size_t size)
+{
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+
+  if (void * pointer = std::malloc(size == 0 ? 1 : size))
+  {
+    return pointer;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void * pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void * pointer, size_t) noexcept
+{
+  std::free(pointer);
+}
+
+BENCHMARK(BM_Tick)->Apply(AllScenarios)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Hash)->Apply(AllScenarios)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
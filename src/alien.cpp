@@ -1,5 +1,8 @@
 #include "except.hpp"
 #include "alien.hpp"
+#include "snapshot.hpp"
+
+#include <initializer_list>
 
 
 Alien::~ Alien()
@@ -39,44 +42,59 @@ bool Alien::Shot()
   return shot;
 }
 
-void Alien::IncreaseX(float const &value)
+QVector2D const & Alien::GetFormationOffset() const
 {
-  float tmp = m_position.x() + value;
+  return m_formationOffset;
+}
 
-  // Set right wall.
-  if (tmp > Globals::Width)
-  {
-    m_position.setX(m_position.x() - 10.0f);
+void Alien::SetFormationOffset(QVector2D const & offset)
+{
+  m_formationOffset = offset;
+}
 
-    ReverseDirection();
-  }
-  else
+void Alien::SetEntryPath(QVector2D const & start,
+                         QVector2D const & control,
+                         float duration)
+{
+  m_pathStart = start;
+  m_pathControl = control;
+  m_pathEnd = m_formationOffset;
+  m_pathTime = 0.0f;
+  m_pathDuration = duration;
+
+  if (m_pathDuration > 0.0f)
   {
-    m_position.setX(tmp);
+    m_formationOffset = m_pathStart;
   }
 }
 
-void Alien::DecreaseX(float const &value)
+void Alien::UpdateEntryPath(float elapsedSeconds)
 {
-
-  // Set left wall.
-  float tmp = m_position.x() - value;
-
-  if (tmp < 0.0f)
+  if (m_pathTime >= m_pathDuration)
   {
-    m_position.setX(m_position.x() + 10.0f);
-
-    ReverseDirection();
+    return;
   }
-  else
+
+  m_pathTime += elapsedSeconds;
+
+  if (m_pathTime >= m_pathDuration)
   {
-    m_position.setX(tmp);
+    m_formationOffset = m_pathEnd;
+    return;
   }
+
+  // Quadratic Bezier curve.
+  float const t = m_pathTime / m_pathDuration;
+  float const s = 1.0f - t;
+
+  m_formationOffset = m_pathStart * (s * s) + m_pathControl * (2.0f * s * t) + m_pathEnd * (t * t);
 }
 
-void Alien::ReverseDirection()
+void Alien::ScaleEntryPath(float x, float y)
 {
-  SetSpeed(-GetSpeed());
+  m_pathStart = QVector2D(m_pathStart.x() * x, m_pathStart.y() * y);
+  m_pathControl = QVector2D(m_pathControl.x() * x, m_pathControl.y() * y);
+  m_pathEnd = QVector2D(m_pathEnd.x() * x, m_pathEnd.y() * y);
 }
 
 int Alien::GetAbsoluteSpeed() const
@@ -93,3 +111,42 @@ std::ostream & operator << (std::ostream & os,
 //     << "; Speed: " << obj.GetSpeed() << "]";
   return os;
 }
+
+void Alien::Save(Snapshot & snapshot) const
+{
+  GameEntityWithWeapon::Save(snapshot);
+
+  snapshot.Write(m_speed);
+  snapshot.Write(m_shotTime);
+  snapshot.Write(m_frequency);
+  snapshot.Write(m_formationOffset.x());
+  snapshot.Write(m_formationOffset.y());
+
+  for (QVector2D const & point : { m_pathStart, m_pathControl, m_pathEnd })
+  {
+    snapshot.Write(point.x());
+    snapshot.Write(point.y());
+  }
+  snapshot.Write(m_pathTime);
+  snapshot.Write(m_pathDuration);
+}
+
+void Alien::Restore(Snapshot & snapshot)
+{
+  GameEntityWithWeapon::Restore(snapshot);
+
+  snapshot.Read(m_speed);
+  snapshot.Read(m_shotTime);
+  snapshot.Read(m_frequency);
+
+  float const x = snapshot.Read<float>();
+  m_formationOffset = QVector2D(x, snapshot.Read<float>());
+
+  for (QVector2D * point : { &m_pathStart, &m_pathControl, &m_pathEnd })
+  {
+    float const pointX = snapshot.Read<float>();
+    *point = QVector2D(pointX, snapshot.Read<float>());
+  }
+  snapshot.Read(m_pathTime);
+  snapshot.Read(m_pathDuration);
+}
@@ -23,10 +23,9 @@ public:
         QVector2D const & position,
         uint const & rate,
         int const & health,
-        std::shared_ptr<QImage> image,
         TSize const & size,
         uint const & frequency)
-    : GameEntityWithWeapon(position, "Alien", rate, health, image, size),
+    : GameEntityWithWeapon(position, "Alien", rate, health, size),
       m_speed(speed),
       m_shotTime(frequency),
       m_frequency(frequency)
@@ -34,23 +33,54 @@ public:
 
   ~Alien() override;
 
+  void Save(Snapshot & snapshot) const override;
+  void Restore(Snapshot & snapshot) override;
+
   void Move() override;
   void Update() override;
   int GetSpeed() const;
   int GetAbsoluteSpeed() const;
   void SetSpeed(int const & rate);
-  void IncreaseX(float const & value) override;
-  void DecreaseX(float const & value) override;
   bool Shot();
-  
-private:
-  // Change direction.
-  void ReverseDirection();
 
+  ///
+  /// Offset of the alien in its formation.
+  ///
+  QVector2D const & GetFormationOffset() const;
+  void SetFormationOffset(QVector2D const & offset);
+
+  ///
+  /// Fly to the current formation offset. The offset moves from the start
+  /// through the control point to the place in the given time.
+  ///
+  void SetEntryPath(QVector2D const & start,
+                    QVector2D const & control,
+                    float duration);
+
+  ///
+  /// Move the formation offset along the entry path.
+  /// It does nothing if the alien is in its place.
+  ///
+  void UpdateEntryPath(float elapsedSeconds);
+
+  ///
+  /// Scale the points of the entry path, it is used on resize.
+  ///
+  void ScaleEntryPath(float x, float y);
+
+private:
   uint m_speed = 0;
   uint m_shotTime = 0;
   uint m_frequency = 0;
 
+  QVector2D m_formationOffset;
+
+  // Entry path, the end is the place in the formation.
+  QVector2D m_pathStart;
+  QVector2D m_pathControl;
+  QVector2D m_pathEnd;
+  float m_pathTime = 0.0f;
+  float m_pathDuration = 0.0f;
 };
 
 using TAlienPtr = std::shared_ptr<Alien>;
@@ -14,5 +14,7 @@ struct AlienParameters : SizeParameters
   size_t m_rowNumber = 0;
   uint m_frequency = 0;
   size_t m_score = 0;
+  // The formation moves down by this distance on every bounce off a wall.
+  int m_stepDown = 0;
 };
 
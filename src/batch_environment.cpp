@@ -0,0 +1,259 @@
+#include "batch_environment.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "settings.hpp"
+#include "images.hpp"
+#include "random.hpp"
+
+size_t constexpr BatchEnvironment::kMaxAliens;
+size_t constexpr BatchEnvironment::kMaxAlienBullets;
+size_t constexpr BatchEnvironment::kMaxSpaceShipBullets;
+size_t constexpr BatchEnvironment::kObservationSize;
+
+namespace
+{
+
+///
+/// Write (x, y, 1) of every entity and zeros for the empty slotsNumber.
+///
+template<typename T>
+float * ObserveList(float * out,
+                    std::list<std::shared_ptr<T>> const & list,
+                    size_t slotsNumber,
+                    float scaleX,
+                    float scaleY)
+{
+  size_t slot = 0;
+
+  for (auto it = list.cbegin(); it != list.cend() && slot < slotsNumber; ++it, ++slot)
+  {
+    *out++ = (*it)->GetPosition().x() * scaleX;
+    *out++ = (*it)->GetPosition().y() * scaleY;
+    *out++ = 1.0f;
+  }
+
+  std::fill(out, out + 3 * (slotsNumber - slot), 0.0f);
+
+  return out + 3 * (slotsNumber - slot);
+}
+
+} // namespace
+
+BatchEnvironment::BatchEnvironment(size_t instances,
+                                   size_t level,
+                                   uint64_t seed,
+                                   size_t threads,
+                                   size_t frameSkip)
+  : m_context(GameContext::FromSettings()),
+    m_level(level),
+    m_seed(seed),
+    m_frameSkip(std::max<size_t>(1, frameSkip)),
+    m_worlds(instances),
+    m_episodes(instances, 0),
+    m_observations(instances * kObservationSize, 0.0f),
+    m_rewards(instances, 0.0f),
+    m_dones(instances, 0),
+    m_threadPool(threads)
+{
+  Reset();
+}
+
+void BatchEnvironment::Reset()
+{
+  m_threadPool.ParallelFor(m_worlds.size(), [this](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      ResetInstance(i);
+      m_rewards[i] = 0.0f;
+      m_dones[i] = 0;
+    }
+  });
+}
+
+void BatchEnvironment::Step(BatchAction const * actions)
+{
+  m_threadPool.ParallelFor(m_worlds.size(), [this, actions](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      StepInstance(i, actions[i]);
+    }
+  });
+}
+
+size_t BatchEnvironment::GetSize() const
+{
+  return m_worlds.size();
+}
+
+float const * BatchEnvironment::GetObservations() const
+{
+  return m_observations.data();
+}
+
+float const * BatchEnvironment::GetRewards() const
+{
+  return m_rewards.data();
+}
+
+uint8_t const * BatchEnvironment::GetDones() const
+{
+  return m_dones.data();
+}
+
+uint64_t BatchEnvironment::GetTotalTicks() const
+{
+  uint64_t ticks = 0;
+
+  for (auto const & world : m_worlds)
+  {
+    ticks += world->GetTick();
+  }
+
+  return ticks;
+}
+
+bool BatchEnvironment::RunBenchmark(size_t instances, size_t steps, std::ostream & os)
+{
+  try
+  {
+    Images::Instance().LoadImages();
+
+    Settings::Instance().LoadMainSettings();
+    Settings::Instance().LoadLevelSettings("1");
+  }
+  catch (std::exception const & ex)
+  {
+    os << ex.what() << std::endl;
+
+    return false;
+  }
+
+  BatchEnvironment environment(instances, 1, Settings::Instance().m_mainParameters.m_seed);
+
+  Pcg32 random;
+  random.Seed(Settings::Instance().m_mainParameters.m_seed, 0);
+
+  std::vector<BatchAction> actions(instances);
+  size_t episodes = 0;
+
+  auto const start = std::chrono::steady_clock::now();
+
+  for (size_t step = 0; step < steps; ++step)
+  {
+    for (auto & action : actions)
+    {
+      action = static_cast<BatchAction>(random.Next() % static_cast<uint32_t>(BatchAction::Count));
+    }
+
+    environment.Step(actions.data());
+
+    episodes += std::count(environment.GetDones(),
+                           environment.GetDones() + instances, 1);
+  }
+
+  auto const finish = std::chrono::steady_clock::now();
+
+  double const seconds = std::chrono::duration<double>(finish - start).count();
+  double const totalSteps = static_cast<double>(instances) * steps;
+
+  os << "Instances: " << instances << ", threads: " << environment.m_threadPool.GetSize() << std::endl
+     << "Steps: " << totalSteps << ", finished episodes: " << episodes << std::endl
+     << "Time: " << seconds << " s, "
+     << (seconds > 0.0 ? totalSteps / seconds : 0.0) << " steps/s" << std::endl;
+
+  return true;
+}
+
+void BatchEnvironment::ResetInstance(size_t index)
+{
+  // Every game and every episode gets its own random sequence.
+  uint64_t const seed = m_seed + (static_cast<uint64_t>(index) << 32) + m_episodes[index];
+  m_episodes[index]++;
+
+  // The first episode creates the world, the next ones reuse its memory.
+  if (m_worlds[index] == nullptr)
+  {
+    m_worlds[index].reset(new World(m_context, m_level));
+    m_worlds[index]->Initialize(seed);
+  }
+  else
+  {
+    m_worlds[index]->Reset(seed);
+  }
+
+  Observe(index);
+}
+
+void BatchEnvironment::StepInstance(size_t index, BatchAction action)
+{
+  World & world = *m_worlds[index];
+
+  bool const isLeft = action == BatchAction::Left || action == BatchAction::LeftFire;
+  bool const isRight = action == BatchAction::Right || action == BatchAction::RightFire;
+  bool const isFire = action == BatchAction::Fire ||
+      action == BatchAction::LeftFire ||
+      action == BatchAction::RightFire;
+
+  InputCommand command;
+
+  command.m_action = InputAction::Left;
+  command.m_isPressed = isLeft;
+  world.Apply(command);
+
+  command.m_action = InputAction::Right;
+  command.m_isPressed = isRight;
+  world.Apply(command);
+
+  if (isFire)
+  {
+    command.m_action = InputAction::Fire;
+    command.m_isPressed = true;
+    world.Apply(command);
+  }
+
+  size_t const score = world.GetScore();
+
+  for (size_t i = 0; i < m_frameSkip && world.GetGameState() == GameState::RUNINIG; ++i)
+  {
+    world.Tick(World::kFixedTimeStep);
+  }
+
+  m_rewards[index] = static_cast<float>(static_cast<double>(world.GetScore()) - score);
+  m_dones[index] = world.GetGameState() != GameState::RUNINIG;
+
+  if (m_dones[index])
+  {
+    ResetInstance(index);
+  }
+  else
+  {
+    Observe(index);
+  }
+}
+
+void BatchEnvironment::Observe(size_t index)
+{
+  World const & world = *m_worlds[index];
+  Space & space = *world.GetSpace();
+
+  QSize const fieldSize = world.GetFieldSize();
+  float const scaleX = fieldSize.width() > 0 ? 1.0f / fieldSize.width() : 0.0f;
+  float const scaleY = fieldSize.height() > 0 ? 1.0f / fieldSize.height() : 0.0f;
+
+  int const health = m_context.m_parameters.m_spaceShipParameters.m_health;
+
+  float * out = m_observations.data() + index * kObservationSize;
+
+  TSpaceShipPtr const & spaceShip = space.GetSpaceShip();
+  *out++ = spaceShip->GetPosition().x() * scaleX;
+  *out++ = spaceShip->GetPosition().y() * scaleY;
+  *out++ = health > 0 ? static_cast<float>(spaceShip->GetHealth()) / health : 0.0f;
+
+  out = ObserveList(out, space.GetAliens(), kMaxAliens, scaleX, scaleY);
+  out = ObserveList(out, space.GetAlienBullets(), kMaxAlienBullets, scaleX, scaleY);
+  ObserveList(out, space.GetSpaceShipBullets(), kMaxSpaceShipBullets, scaleX, scaleY);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "world.hpp"
+#include "thread_pool.hpp"
+
+///
+/// Discrete actions of an agent.
+///
+enum class BatchAction : int32_t
+{
+  Noop,
+  Left,
+  Right,
+  Fire,
+  LeftFire,
+  RightFire,
+  Count
+};
+
+///
+/// Many independent games stepped together for bots and training.
+///
+/// Every Step() advances all games by the same number of ticks.
+/// Observations, rewards and done flags of all games are stored
+/// in contiguous arrays, one row per game. A finished game is
+/// reset at once, so its row holds the first state of a new episode.
+///
+/// Settings and images must be loaded before.
+///
+class BatchEnvironment
+{
+public:
+  /// Maximal number of entities of each kind in the observation.
+  static size_t constexpr kMaxAliens = 64;
+  static size_t constexpr kMaxAlienBullets = 16;
+  static size_t constexpr kMaxSpaceShipBullets = 8;
+
+  ///
+  /// The space ship (x, y, health), then slots of aliens, alien bullets
+  /// and space ship bullets (x, y, presence). Coordinates are divided
+  /// by the field size, the health by the initial health.
+  ///
+  static size_t constexpr kObservationSize =
+      3 + 3 * (kMaxAliens + kMaxAlienBullets + kMaxSpaceShipBullets);
+
+  ///
+  /// threads = 0 uses all hardware cores.
+  /// frameSkip is the number of ticks simulated by one step with the same action.
+  ///
+  BatchEnvironment(size_t instances,
+                   size_t level = 1,
+                   uint64_t seed = 1,
+                   size_t threads = 0,
+                   size_t frameSkip = 1);
+
+  ///
+  /// Start new episodes in all games.
+  ///
+  void Reset();
+
+  ///
+  /// Apply one action per game and advance all games.
+  ///
+  void Step(BatchAction const * actions);
+
+  size_t GetSize() const;
+
+  /// GetSize() rows of kObservationSize values.
+  float const * GetObservations() const;
+
+  /// Score gained by the last step.
+  float const * GetRewards() const;
+
+  /// 1 if the episode ended on the last step.
+  uint8_t const * GetDones() const;
+
+  /// Number of simulated ticks of all games.
+  uint64_t GetTotalTicks() const;
+
+  ///
+  /// Step the games with random actions and print the throughput.
+  ///
+  /// Return false if the game data can't be loaded.
+  ///
+  static bool RunBenchmark(size_t instances, size_t steps, std::ostream & os);
+
+private:
+  void ResetInstance(size_t index);
+  void StepInstance(size_t index, BatchAction action);
+  void Observe(size_t index);
+
+  // Every game gets a copy of it.
+  GameContext m_context;
+
+  size_t m_level;
+  uint64_t m_seed;
+  size_t m_frameSkip;
+
+  std::vector<std::unique_ptr<World>> m_worlds;
+
+  // Number of started episodes of every game, it varies the seed.
+  std::vector<uint64_t> m_episodes;
+
+  std::vector<float> m_observations;
+  std::vector<float> m_rewards;
+  std::vector<uint8_t> m_dones;
+
+  ThreadPool m_threadPool;
+};
@@ -1,5 +1,6 @@
 #include "except.hpp"
 #include "bullet.hpp"
+#include "snapshot.hpp"
 
 
 Bullet::~Bullet()
@@ -26,8 +27,16 @@ void Bullet::Move()
 {
   throw NotImplementedException();
 }
-void Bullet::IncreaseY(float const & value) {
+void Bullet::IncreaseY(float const & value, QSize const &) {
   m_position.setY(m_position.y() + value);
+  UpdateBox();
+}
+
+// Bullets are not stopped by the bottom wall,
+// they are removed once they leave the play field.
+void Bullet::DecreaseY(float const & value, QSize const &) {
+  m_position.setY(m_position.y() - value);
+  UpdateBox();
 }
 
 std::ostream & operator << (std::ostream & os,
@@ -39,3 +48,17 @@ std::ostream & operator << (std::ostream & os,
 //     << "; Damage: " << obj.GetDamage() << "]";
   return os;
 }
+
+void Bullet::Save(Snapshot & snapshot) const
+{
+  GameEntity::Save(snapshot);
+
+  snapshot.Write(m_damage);
+}
+
+void Bullet::Restore(Snapshot & snapshot)
+{
+  GameEntity::Restore(snapshot);
+
+  snapshot.Read(m_damage);
+}
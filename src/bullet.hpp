@@ -19,21 +19,24 @@ public:
   {}
 
   Bullet(QVector2D const & position,
-         std::shared_ptr<QImage> image,
          uint const & damage,
          TSize const & size) :
-    GameEntity(position, "Bullet", image, size),
+    GameEntity(position, "Bullet", size),
     m_damage(damage)
   {}
 
   ~Bullet() override;
 
+  void Save(Snapshot & snapshot) const override;
+  void Restore(Snapshot & snapshot) override;
+
   void Update() override;
   void Move() override;
 
   uint GetDamage() const;
   void SetDamage(uint const & damage);
-  virtual void IncreaseY(float const &value) override;
+  void IncreaseY(float const & value, QSize const & fieldSize) override;
+  void DecreaseY(float const & value, QSize const & fieldSize) override;
 
 private:
   uint m_damage = 0;
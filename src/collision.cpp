@@ -0,0 +1,23 @@
+#include "collision.hpp"
+
+#include <algorithm>
+#include <limits>
+
+Box2D Collision::GetEmptyBounds()
+{
+  float constexpr kMax = std::numeric_limits<float>::max();
+
+  // Min is greater than max, so every overlap test fails.
+  Box2D bounds;
+  bounds.setBoxMin(Point2D(kMax, kMax));
+  bounds.SetBoxMax(Point2D(-kMax, -kMax));
+  return bounds;
+}
+
+void Collision::Extend(Box2D & bounds, Box2D const & box)
+{
+  bounds.setBoxMin(Point2D(std::min(bounds.boxMin().x(), box.boxMin().x()),
+                           std::min(bounds.boxMin().y(), box.boxMin().y())));
+  bounds.SetBoxMax(Point2D(std::max(bounds.boxMax().x(), box.boxMax().x()),
+                           std::max(bounds.boxMax().y(), box.boxMax().y())));
+}
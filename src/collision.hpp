@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "box2d.hpp"
+#include "game_entity.hpp"
+
+///
+/// A pair of overlapping entities found by the detect phase.
+///
+/// Indices are positions of the entities in their lists
+/// at the moment of the detection.
+///
+struct Contact
+{
+  // The entity which is hit.
+  uint32_t m_target;
+  // The entity which hits, usually a bullet.
+  uint32_t m_other;
+  // Which list m_other belongs to, if a pass checks several lists.
+  uint32_t m_group;
+};
+
+///
+/// Broad phase of the collision passes.
+///
+/// A pass gathers boxes of the entities, detects contacts and then
+/// resolves them in bulk. All buffers are owned by the caller and keep
+/// their capacity, so a pass doesn't allocate in a steady game.
+///
+class Collision
+{
+public:
+  Collision() = delete;
+  Collision(Collision const &) = delete;
+  Collision(Collision const &&) = delete;
+  Collision & operator=(Collision const &) = delete;
+  Collision & operator=(Collision const &&) = delete;
+
+  ///
+  /// Bounds of an empty group. They don't overlap any box.
+  ///
+  static Box2D GetEmptyBounds();
+
+  ///
+  /// Extend the bounds of a group by a box.
+  ///
+  static void Extend(Box2D & bounds, Box2D const & box);
+
+  ///
+  /// Fill the entities and their cached boxes in the list order.
+  ///
+  /// bounds receives the union of the boxes, so a pass can reject
+  /// the whole group with one test.
+  ///
+  /// Boxes may be in any vector, a pass of one step keeps them in the frame arena.
+  ///
+  template <typename T, typename TBoxes>
+  static void Gather(std::list<std::shared_ptr<T>> const & list,
+                     std::vector<T *> & entities,
+                     TBoxes & boxes,
+                     Box2D & bounds)
+  {
+    entities.clear();
+    boxes.clear();
+    boxes.reserve(list.size());
+    bounds = GetEmptyBounds();
+
+    for (auto const & entity : list)
+    {
+      entities.push_back(entity.get());
+      boxes.push_back(entity->GetBox());
+      Extend(bounds, boxes.back());
+    }
+  }
+
+  ///
+  /// Add contacts of the target with the boxes which overlap it
+  /// and are not used yet. Found boxes are marked as used,
+  /// so every box takes part in one contact at most.
+  ///
+  /// limit - maximum number of contacts, 0 means no limit.
+  /// tests - it is increased by the number of tested pairs.
+  ///
+  /// Returns the number of added contacts.
+  ///
+  template <typename TBoxes, typename TContacts>
+  static size_t Detect(uint32_t target,
+                       Box2D const & targetBox,
+                       TBoxes const & boxes,
+                       std::vector<uint8_t> & used,
+                       uint32_t group,
+                       size_t limit,
+                       TContacts & contacts,
+                       uint64_t & tests)
+  {
+    size_t found = 0;
+
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+      if (used[i])
+      {
+        continue;
+      }
+
+      ++tests;
+
+      if (!Box2D::checkBoxes(targetBox, boxes[i]))
+      {
+        continue;
+      }
+
+      used[i] = 1;
+      contacts.push_back({ target, static_cast<uint32_t>(i), group });
+
+      if (++found == limit)
+      {
+        break;
+      }
+    }
+
+    return found;
+  }
+};
@@ -3,7 +3,10 @@
 constexpr float Constants::kEps;
 constexpr float Constants::PI;
 
-int Globals::Height = 768;
-int Globals::Width = 1024;
+int const Globals::Height = 768;
+int const Globals::Width = 1024;
 
-std::string Globals::SettingsFileName = "settings.json";
\ No newline at end of file
+std::string Globals::SettingsFileName = "settings.json";
+std::string Globals::ScoresFileName = "scores.log";
+std::string Globals::UserSettingsFileName = "user_settings.json";
+std::string Globals::TextureCacheDirectory = "texture_cache";
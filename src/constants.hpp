@@ -10,7 +10,13 @@ struct Constants
 
 struct Globals
 {
-  static int Height;
-  static int Width;
+  /// Initial size of the game field. Every game keeps its own size in GameContext.
+  static int const Height;
+  static int const Width;
   static std::string SettingsFileName;
+  static std::string ScoresFileName;
+  /// User preferences which override the settings file.
+  static std::string UserSettingsFileName;
+  /// Converted textures which are uploaded without processing.
+  static std::string TextureCacheDirectory;
 };
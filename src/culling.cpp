@@ -0,0 +1,26 @@
+#include "culling.hpp"
+
+bool Culling::IsVisible(QVector2D const & position,
+                        TSize const & size,
+                        QSize const & screenSize)
+{
+  float const halfWidth = 0.5f * size.first;
+  float const halfHeight = 0.5f * size.second;
+
+  return not (position.x() + halfWidth < 0.0f ||
+              position.x() - halfWidth > screenSize.width() ||
+              position.y() + halfHeight < 0.0f ||
+              position.y() - halfHeight > screenSize.height());
+}
+
+bool Culling::IsOutside(QVector2D const & position,
+                        TSize const & size,
+                        QSize const & screenSize)
+{
+  // The collision box lies to the right and above the position
+  // while the sprite is centered, so check the union of both.
+  return position.x() + size.first < 0.0f ||
+         position.x() - 0.5f * size.first > screenSize.width() ||
+         position.y() + size.second < 0.0f ||
+         position.y() - 0.5f * size.second > screenSize.height();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <QSize>
+#include <QVector2D>
+
+#include "game_entity.hpp"
+
+///
+/// Viewport tests for game entities.
+///
+/// TexturedRect draws a sprite centered at its position,
+/// so the visible rectangle is position +/- size / 2.
+///
+class Culling
+{
+public:
+  Culling() = delete;
+  Culling(Culling const &) = delete;
+  Culling(Culling const &&) = delete;
+  Culling & operator=(Culling const &) = delete;
+  Culling & operator=(Culling const &&) = delete;
+
+  ///
+  /// Check if a sprite overlaps the screen.
+  ///
+  static bool IsVisible(QVector2D const & position,
+                        TSize const & size,
+                        QSize const & screenSize);
+
+  ///
+  /// Check if an entity has completely left the play field.
+  ///
+  /// It takes into account both the drawn sprite and
+  /// the collision box (position, position + size).
+  ///
+  static bool IsOutside(QVector2D const & position,
+                        TSize const & size,
+                        QSize const & screenSize);
+};
@@ -35,6 +35,11 @@ const char *WriteFileException::what() const noexcept
 {
   return m_message.c_str();
 }
+const char * ReadSnapshotException::what() const noexcept
+{
+  return "Can't restore the game from a snapshot!";
+}
+
 const char * WrongLevelException::what() const noexcept
 {
   return m_message.c_str();
@@ -80,6 +80,14 @@ private:
   std::string m_message;
 };
 
+class ReadSnapshotException : public std::exception
+{
+public:
+  ReadSnapshotException() = default;
+
+  virtual const char * what() const noexcept;
+};
+
 class WrongLevelException : public std::exception
 {
  public:
@@ -5,8 +5,14 @@
 
 struct ExplosionParameters : SizeParameters
 {
+  /// Lifetimes in the steps of the fixed step mode.
   uint m_lifetime = 0;
   uint m_lifetimeBig = 0;
   TSize m_size = std::make_pair(0, 0);;
   TSize m_sizeBig = std::make_pair(0, 0);
+
+  /// Debris particles of a small explosion, a big one has twice as many.
+  uint m_particles = 0;
+  /// Speed of the debris in pixels per second.
+  float m_speed = 0.0f;
 };
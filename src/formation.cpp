@@ -0,0 +1,124 @@
+#include "formation.hpp"
+
+#include <algorithm>
+
+#include "snapshot.hpp"
+
+Formation::Formation(float speed, float stepDown)
+  : m_velocity(speed),
+    m_stepDown(stepDown)
+{}
+
+void Formation::Update(float elapsedSeconds,
+                       std::list<TAlienPtr> const & aliens,
+                       QSize const & fieldSize)
+{
+  if (aliens.size() != m_boundsCount)
+  {
+    UpdateBounds(aliens);
+  }
+
+  if (aliens.empty())
+  {
+    return;
+  }
+
+  float distance = m_velocity * elapsedSeconds;
+
+  float const left = m_offset.x() + m_left;
+  float const right = m_offset.x() + m_right;
+
+  // Stop at the wall, turn back and step down.
+  if (m_velocity > 0.0f && right + distance > fieldSize.width())
+  {
+    distance = std::max(0.0f, fieldSize.width() - right);
+    m_velocity = -m_velocity;
+    m_offset.setY(m_offset.y() - m_stepDown);
+  }
+  else if (m_velocity < 0.0f && left + distance < 0.0f)
+  {
+    distance = std::min(0.0f, -left);
+    m_velocity = -m_velocity;
+    m_offset.setY(m_offset.y() - m_stepDown);
+  }
+
+  m_offset.setX(m_offset.x() + distance);
+}
+
+QVector2D const & Formation::GetOffset() const
+{
+  return m_offset;
+}
+
+float Formation::GetVelocity() const
+{
+  return m_velocity;
+}
+
+Box2D Formation::GetBounds() const
+{
+  // A pixel of margin covers the rounding of the derived positions.
+  float constexpr kMargin = 1.0f;
+
+  Box2D bounds;
+  bounds.setBoxMin(Point2D(m_offset.x() + m_left - kMargin, m_offset.y() + m_bottom - kMargin));
+  bounds.SetBoxMax(Point2D(m_offset.x() + m_right + kMargin, m_offset.y() + m_top + kMargin));
+  return bounds;
+}
+
+void Formation::Scale(std::list<TAlienPtr> const & aliens, float x, float y)
+{
+  m_offset = QVector2D(m_offset.x() * x, m_offset.y() * y);
+
+  for (auto const & alien : aliens)
+  {
+    QVector2D const & offset = alien->GetFormationOffset();
+    alien->SetFormationOffset(QVector2D(offset.x() * x, offset.y() * y));
+    alien->ScaleEntryPath(x, y);
+    ApplyTo(*alien);
+  }
+
+  UpdateBounds(aliens);
+}
+
+void Formation::Invalidate()
+{
+  m_boundsCount = std::numeric_limits<size_t>::max();
+}
+
+void Formation::Save(Snapshot & snapshot) const
+{
+  snapshot.Write(m_offset.x());
+  snapshot.Write(m_offset.y());
+  snapshot.Write(m_velocity);
+  snapshot.Write(m_stepDown);
+}
+
+void Formation::Restore(Snapshot & snapshot)
+{
+  float const x = snapshot.Read<float>();
+  m_offset = QVector2D(x, snapshot.Read<float>());
+  snapshot.Read(m_velocity);
+  snapshot.Read(m_stepDown);
+
+  Invalidate();
+}
+
+void Formation::UpdateBounds(std::list<TAlienPtr> const & aliens)
+{
+  // An empty formation gets inverted bounds which don't overlap anything.
+  m_left = m_bottom = std::numeric_limits<float>::max();
+  m_right = m_top = std::numeric_limits<float>::lowest();
+
+  for (auto const & alien : aliens)
+  {
+    QVector2D const & offset = alien->GetFormationOffset();
+
+    m_left = std::min(m_left, offset.x());
+    m_right = std::max(m_right, offset.x() + alien->GetSize().first);
+    m_bottom = std::min(m_bottom, offset.y());
+    m_top = std::max(m_top, offset.y() + alien->GetSize().second);
+  }
+
+  m_boundsCount = aliens.size();
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <QSize>
+#include <QVector2D>
+
+#include <list>
+#include <limits>
+
+#include "alien.hpp"
+#include "box2d.hpp"
+
+class Snapshot;
+
+///
+/// Movement of the aliens as one group.
+///
+/// Every alien keeps its local offset in the formation. The formation
+/// moves one group offset, bounces off the walls by its bounding box
+/// and steps down on every bounce, so the rows stay in line however
+/// large the formation is. Positions of the aliens are derived from
+/// the group offset by ApplyTo().
+///
+class Formation
+{
+public:
+  Formation() = default;
+
+  ///
+  /// speed - horizontal speed in pixels per second, positive is to the right.
+  /// stepDown - distance the formation moves down on every bounce.
+  ///
+  Formation(float speed, float stepDown);
+
+  ///
+  /// Move the group and bounce off the walls of the field.
+  ///
+  void Update(float elapsedSeconds,
+              std::list<TAlienPtr> const & aliens,
+              QSize const & fieldSize);
+
+  ///
+  /// Position of an alien in the field.
+  ///
+  QVector2D GetPosition(Alien const & alien) const
+  {
+    return m_offset + alien.GetFormationOffset();
+  }
+
+  ///
+  /// Set the position of an alien from its local offset.
+  ///
+  void ApplyTo(Alien & alien) const
+  {
+    alien.SetPosition(GetPosition(alien));
+  }
+
+  QVector2D const & GetOffset() const;
+  float GetVelocity() const;
+
+  ///
+  /// Union of the collision boxes of the aliens in the field.
+  ///
+  /// It costs nothing per alien. It may be larger than the group
+  /// if aliens were removed after the last update.
+  ///
+  Box2D GetBounds() const;
+
+  ///
+  /// Scale the group offset and the local offsets, it is used on resize.
+  ///
+  void Scale(std::list<TAlienPtr> const & aliens, float x, float y);
+
+  ///
+  /// The bounding box is recalculated on the next update.
+  /// It must be called if aliens were added or changed their offsets.
+  ///
+  void Invalidate();
+
+  ///
+  /// Recalculate the bounding box for the aliens.
+  ///
+  void UpdateBounds(std::list<TAlienPtr> const & aliens);
+
+  void Save(Snapshot & snapshot) const;
+  void Restore(Snapshot & snapshot);
+
+private:
+  QVector2D m_offset;
+  float m_velocity = 0.0f;
+  float m_stepDown = 0.0f;
+
+  // Bounds of the collision boxes in the local space.
+  float m_left = 0.0f;
+  float m_right = 0.0f;
+  float m_bottom = 0.0f;
+  float m_top = 0.0f;
+
+  // The number of aliens the bounds were calculated for.
+  size_t m_boundsCount = std::numeric_limits<size_t>::max();
+};
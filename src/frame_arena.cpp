@@ -0,0 +1,74 @@
+#include "frame_arena.hpp"
+
+#include <algorithm>
+
+FrameArena::FrameArena(size_t capacity)
+  : m_block(capacity > 0 ? new unsigned char[capacity] : nullptr),
+    m_capacity(capacity),
+    m_heapAllocations(capacity > 0 ? 1 : 0)
+{}
+
+void * FrameArena::Allocate(size_t size, size_t alignment)
+{
+  ++m_allocations;
+
+  // The block is aligned for any type, so offsets are aligned instead of addresses.
+  size_t const offset = (m_offset + alignment - 1) & ~(alignment - 1);
+
+  if (m_block != nullptr && offset + size <= m_capacity)
+  {
+    m_used += offset + size - m_offset;
+    m_offset = offset + size;
+    return m_block.get() + offset;
+  }
+
+  m_used += size;
+  ++m_heapAllocations;
+
+  m_overflow.emplace_back(new unsigned char[std::max<size_t>(size, 1)]);
+  return m_overflow.back().get();
+}
+
+void FrameArena::Reset()
+{
+  m_peak = std::max(m_peak, m_used);
+
+  // The next step of the same size fits the block.
+  if (!m_overflow.empty())
+  {
+    m_overflow.clear();
+
+    m_capacity = std::max(2 * m_capacity, m_used);
+    m_block.reset(new unsigned char[m_capacity]);
+    ++m_heapAllocations;
+  }
+
+  m_offset = 0;
+  m_used = 0;
+  m_allocations = 0;
+}
+
+size_t FrameArena::GetUsed() const
+{
+  return m_used;
+}
+
+size_t FrameArena::GetAllocations() const
+{
+  return m_allocations;
+}
+
+size_t FrameArena::GetPeak() const
+{
+  return std::max(m_peak, m_used);
+}
+
+size_t FrameArena::GetCapacity() const
+{
+  return m_capacity;
+}
+
+uint64_t FrameArena::GetHeapAllocations() const
+{
+  return m_heapAllocations;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+///
+/// Bump allocator of the data which lives during one step.
+///
+/// Memory is taken from one block and is released all at once
+/// by Reset(). A request which doesn't fit is served from the heap,
+/// and the block grows at the next reset, so a steady game takes
+/// no memory from the heap.
+///
+/// It isn't thread safe, one stage of the step uses it at a time.
+///
+class FrameArena
+{
+public:
+  explicit FrameArena(size_t capacity = 0);
+
+  FrameArena(FrameArena const &) = delete;
+  FrameArena & operator=(FrameArena const &) = delete;
+  FrameArena(FrameArena &&) = default;
+  FrameArena & operator=(FrameArena &&) = default;
+
+  ///
+  /// The alignment must be a power of two no greater
+  /// than the alignment of std::max_align_t.
+  ///
+  void * Allocate(size_t size, size_t alignment);
+
+  ///
+  /// Release everything which was allocated since the last reset.
+  ///
+  void Reset();
+
+  /// Bytes and allocations since the last reset.
+  size_t GetUsed() const;
+  size_t GetAllocations() const;
+
+  /// The most bytes used between two resets.
+  size_t GetPeak() const;
+  size_t GetCapacity() const;
+
+  /// Blocks taken from the heap since the arena was created.
+  uint64_t GetHeapAllocations() const;
+
+private:
+  std::unique_ptr<unsigned char[]> m_block;
+  size_t m_capacity = 0;
+  // Offset of the free part of the block.
+  size_t m_offset = 0;
+
+  // Requests which didn't fit the block in this step.
+  std::vector<std::unique_ptr<unsigned char[]>> m_overflow;
+
+  size_t m_used = 0;
+  size_t m_allocations = 0;
+  size_t m_peak = 0;
+  uint64_t m_heapAllocations = 0;
+};
+
+///
+/// Allocator of the standard containers which takes memory
+/// from a frame arena. Deallocation does nothing, the memory
+/// is released by the reset of the arena.
+///
+template<typename T>
+class ArenaAllocator
+{
+public:
+  using value_type = T;
+
+  ArenaAllocator(FrameArena & arena)
+    : m_arena(&arena)
+  {}
+
+  template<typename U>
+  ArenaAllocator(ArenaAllocator<U> const & other)
+    : m_arena(other.GetArena())
+  {}
+
+  T * allocate(size_t count)
+  {
+    return static_cast<T *>(m_arena->Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *, size_t)
+  {}
+
+  FrameArena * GetArena() const
+  {
+    return m_arena;
+  }
+
+private:
+  FrameArena * m_arena;
+};
+
+template<typename T, typename U>
+bool operator == (ArenaAllocator<T> const & lhs, ArenaAllocator<U> const & rhs)
+{
+  return lhs.GetArena() == rhs.GetArena();
+}
+
+template<typename T, typename U>
+bool operator != (ArenaAllocator<T> const & lhs, ArenaAllocator<U> const & rhs)
+{
+  return !(lhs == rhs);
+}
+
+///
+/// Vector of one step. It must not outlive the next reset of its arena.
+///
+template<typename T>
+using TFrameVector = std::vector<T, ArenaAllocator<T>>;
@@ -0,0 +1,328 @@
+#include "frame_recorder.hpp"
+
+#include <QDir>
+#include <QImage>
+#include <QString>
+
+#include <cstring>
+
+#include "except.hpp"
+
+int constexpr FrameRecorder::kRingSize;
+size_t constexpr FrameRecorder::kMaxQueuedFrames;
+int constexpr FrameRecorder::kFramesPerSecond;
+
+FrameRecorder::~FrameRecorder()
+{
+  // GL buffers must be released by Stop() while the context is current,
+  // here it only makes sure the worker thread doesn't outlive the recorder.
+  if (m_worker.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_isStopping = true;
+    }
+    m_condition.notify_all();
+    m_worker.join();
+  }
+}
+
+void FrameRecorder::Start(QOpenGLFunctions * functions,
+                          QSize const & size,
+                          std::string const & path,
+                          Format format)
+{
+  if (m_isRecording || functions == nullptr)
+  {
+    return;
+  }
+
+  m_functions = functions;
+  m_path = path;
+  m_format = format;
+  m_size = size;
+
+  if (m_format == Format::Y4M)
+  {
+    // 4:2:0 chroma subsampling needs even dimensions.
+    m_size = QSize(size.width() & ~1, size.height() & ~1);
+
+    m_stream.open(m_path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!m_stream.is_open())
+    {
+      throw WriteFileException(m_path);
+    }
+
+    m_stream << "YUV4MPEG2 W" << m_size.width()
+             << " H" << m_size.height()
+             << " F" << kFramesPerSecond << ":1 Ip A1:1 C420jpeg\n";
+  }
+  else if (!QDir().mkpath(QString::fromStdString(m_path)))
+  {
+    throw WriteFileException(m_path);
+  }
+
+  int const bytes = m_size.width() * m_size.height() * 4;
+
+  for (auto & buffer : m_ring)
+  {
+    buffer = QOpenGLBuffer(QOpenGLBuffer::PixelPackBuffer);
+    buffer.setUsagePattern(QOpenGLBuffer::StreamRead);
+    buffer.create();
+    buffer.bind();
+    buffer.allocate(bytes);
+    buffer.release();
+  }
+
+  m_pending.fill(false);
+  m_current = 0;
+  m_captured = 0;
+  m_dropped = 0;
+  m_isStopping = false;
+  m_isRecording = true;
+
+  m_worker = std::thread(&FrameRecorder::Run, this);
+}
+
+void FrameRecorder::Stop()
+{
+  if (!m_isRecording)
+  {
+    return;
+  }
+
+  // Collect frames which are still in flight, the oldest first.
+  for (int i = 0; i < kRingSize; ++i)
+  {
+    int const slot = (m_current + i) % kRingSize;
+
+    if (m_pending[slot])
+    {
+      Collect(m_ring[slot]);
+      m_pending[slot] = false;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopping = true;
+  }
+  m_condition.notify_all();
+  m_worker.join();
+
+  for (auto & buffer : m_ring)
+  {
+    buffer.destroy();
+  }
+
+  if (m_stream.is_open())
+  {
+    m_stream.close();
+  }
+
+  m_freeBuffers.clear();
+  m_isRecording = false;
+}
+
+bool FrameRecorder::IsRecording() const
+{
+  return m_isRecording;
+}
+
+void FrameRecorder::Capture()
+{
+  if (!m_isRecording)
+  {
+    return;
+  }
+
+  QOpenGLBuffer & buffer = m_ring[m_current];
+
+  // The slot was filled kRingSize frames ago,
+  // so mapping it shouldn't wait for the GPU.
+  if (m_pending[m_current])
+  {
+    Collect(buffer);
+  }
+
+  // With a pixel pack buffer bound glReadPixels returns immediately,
+  // the last argument is an offset into the buffer.
+  buffer.bind();
+  m_functions->glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  m_functions->glReadPixels(0, 0, m_size.width(), m_size.height(),
+                            GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  buffer.release();
+
+  m_pending[m_current] = true;
+  m_current = (m_current + 1) % kRingSize;
+}
+
+size_t FrameRecorder::GetCapturedFrames() const
+{
+  return m_captured;
+}
+
+size_t FrameRecorder::GetDroppedFrames() const
+{
+  return m_dropped;
+}
+
+void FrameRecorder::Collect(QOpenGLBuffer & buffer)
+{
+  TPixels pixels;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Bound the overhead: if the encoder can't keep up, skip the frame.
+    if (m_queue.size() >= kMaxQueuedFrames)
+    {
+      ++m_dropped;
+      return;
+    }
+
+    if (!m_freeBuffers.empty())
+    {
+      pixels = std::move(m_freeBuffers.back());
+      m_freeBuffers.pop_back();
+    }
+  }
+
+  size_t const bytes = m_size.width() * m_size.height() * 4;
+  pixels.resize(bytes);
+
+  buffer.bind();
+  void const * data = buffer.map(QOpenGLBuffer::ReadOnly);
+
+  if (data == nullptr)
+  {
+    buffer.release();
+    ++m_dropped;
+    return;
+  }
+
+  std::memcpy(pixels.data(), data, bytes);
+  buffer.unmap();
+  buffer.release();
+
+  Frame frame;
+  frame.m_index = m_captured++;
+  frame.m_pixels = std::move(pixels);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.push_back(std::move(frame));
+  }
+  m_condition.notify_one();
+}
+
+void FrameRecorder::Run()
+{
+  while (true)
+  {
+    Frame frame;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+
+      m_condition.wait(lock, [this] {
+        return m_isStopping || !m_queue.empty();
+      });
+
+      // Stop only when all queued frames are written.
+      if (m_queue.empty())
+      {
+        return;
+      }
+
+      frame = std::move(m_queue.front());
+      m_queue.pop_front();
+    }
+
+    Encode(frame);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_freeBuffers.push_back(std::move(frame.m_pixels));
+  }
+}
+
+void FrameRecorder::Encode(Frame const & frame)
+{
+  switch (m_format)
+  {
+    case Format::ImageSequence:
+      EncodeImage(frame);
+      break;
+    case Format::Y4M:
+      EncodeY4M(frame);
+      break;
+  }
+}
+
+void FrameRecorder::EncodeImage(Frame const & frame)
+{
+  QImage image(frame.m_pixels.data(),
+               m_size.width(),
+               m_size.height(),
+               QImage::Format_RGBA8888);
+
+  QString fileName = QString("%1/frame_%2.png")
+      .arg(QString::fromStdString(m_path))
+      .arg(frame.m_index, 6, 10, QChar('0'));
+
+  // OpenGL rows go from the bottom to the top.
+  image.mirrored().save(fileName);
+}
+
+void FrameRecorder::EncodeY4M(Frame const & frame)
+{
+  int const width = m_size.width();
+  int const height = m_size.height();
+  int const chromaWidth = width / 2;
+  int const chromaHeight = height / 2;
+
+  m_yuv.resize(width * height + 2 * chromaWidth * chromaHeight);
+
+  unsigned char * planeY = m_yuv.data();
+  unsigned char * planeU = planeY + width * height;
+  unsigned char * planeV = planeU + chromaWidth * chromaHeight;
+
+  unsigned char const * pixels = frame.m_pixels.data();
+
+  // Full range BT.601 in 8.8 fixed point, rows are flipped on the fly.
+  for (int y = 0; y < height; ++y)
+  {
+    unsigned char const * row = pixels + (height - 1 - y) * width * 4;
+
+    for (int x = 0; x < width; ++x)
+    {
+      int const r = row[x * 4];
+      int const g = row[x * 4 + 1];
+      int const b = row[x * 4 + 2];
+
+      planeY[y * width + x] = (77 * r + 150 * g + 29 * b) >> 8;
+    }
+  }
+
+  for (int y = 0; y < chromaHeight; ++y)
+  {
+    unsigned char const * row0 = pixels + (height - 1 - 2 * y) * width * 4;
+    unsigned char const * row1 = row0 - width * 4;
+
+    for (int x = 0; x < chromaWidth; ++x)
+    {
+      int const i = x * 8;
+
+      int const r = (row0[i] + row0[i + 4] + row1[i] + row1[i + 4]) >> 2;
+      int const g = (row0[i + 1] + row0[i + 5] + row1[i + 1] + row1[i + 5]) >> 2;
+      int const b = (row0[i + 2] + row0[i + 6] + row1[i + 2] + row1[i + 6]) >> 2;
+
+      planeU[y * chromaWidth + x] = (-43 * r - 85 * g + 128 * b + 32768) >> 8;
+      planeV[y * chromaWidth + x] = (128 * r - 107 * g - 21 * b + 32768) >> 8;
+    }
+  }
+
+  m_stream << "FRAME\n";
+  m_stream.write(reinterpret_cast<char const *>(m_yuv.data()), m_yuv.size());
+}
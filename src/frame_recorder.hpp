@@ -0,0 +1,112 @@
+#pragma once
+
+#include <QOpenGLBuffer>
+#include <QOpenGLFunctions>
+#include <QSize>
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+///
+/// It records rendered frames without stalling the render thread.
+///
+/// Every frame is read back into one of the pixel buffer objects of a ring.
+/// The buffer is mapped only when the ring wraps around, so the GPU has had
+/// a couple of frames to finish the transfer. The pixels are handed to a
+/// worker thread which encodes them to an image sequence or a Y4M stream.
+///
+class FrameRecorder
+{
+public:
+  enum class Format
+  {
+    ImageSequence,
+    Y4M
+  };
+
+  FrameRecorder() = default;
+  ~FrameRecorder();
+
+  FrameRecorder(FrameRecorder const &) = delete;
+  FrameRecorder & operator = (FrameRecorder const &) = delete;
+
+  ///
+  /// Start recording. It must be called with the GL context current.
+  ///
+  /// path is a directory for the image sequence and a file for Y4M.
+  ///
+  /// Exception: WriteFileException.
+  ///
+  void Start(QOpenGLFunctions * functions,
+             QSize const & size,
+             std::string const & path,
+             Format format);
+
+  ///
+  /// Flush pending frames and stop the worker.
+  /// It must be called with the GL context current.
+  ///
+  void Stop();
+
+  bool IsRecording() const;
+
+  ///
+  /// Queue a read back of the current framebuffer.
+  ///
+  void Capture();
+
+  size_t GetCapturedFrames() const;
+  size_t GetDroppedFrames() const;
+
+private:
+  using TPixels = std::vector<unsigned char>;
+
+  struct Frame
+  {
+    size_t m_index = 0;
+    TPixels m_pixels;
+  };
+
+  /// Copy the oldest pending buffer to the worker queue.
+  void Collect(QOpenGLBuffer & buffer);
+
+  void Run();
+  void Encode(Frame const & frame);
+  void EncodeImage(Frame const & frame);
+  void EncodeY4M(Frame const & frame);
+
+  static int constexpr kRingSize = 3;
+  static size_t constexpr kMaxQueuedFrames = 8;
+  static int constexpr kFramesPerSecond = 60;
+
+  QOpenGLFunctions * m_functions = nullptr;
+  std::array<QOpenGLBuffer, kRingSize> m_ring;
+  std::array<bool, kRingSize> m_pending = {{ false, false, false }};
+  int m_current = 0;
+
+  QSize m_size;
+  std::string m_path;
+  Format m_format = Format::ImageSequence;
+  bool m_isRecording = false;
+
+  size_t m_captured = 0;
+  size_t m_dropped = 0;
+
+  // Worker thread state.
+  std::thread m_worker;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<Frame> m_queue;
+  std::vector<TPixels> m_freeBuffers;
+  bool m_isStopping = false;
+
+  // Conversion buffers used only by the worker thread.
+  TPixels m_yuv;
+  std::ofstream m_stream;
+};
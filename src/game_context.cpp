@@ -0,0 +1,12 @@
+#include "game_context.hpp"
+
+#include "settings.hpp"
+#include "constants.hpp"
+
+GameContext GameContext::FromSettings()
+{
+  GameContext context;
+  context.m_parameters = Settings::Instance();
+  context.m_fieldSize = QSize(Globals::Width, Globals::Height);
+  return context;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <QSize>
+
+#include "game_parameters.hpp"
+
+///
+/// Everything a game reads while it runs.
+///
+/// Every World owns a copy, so games with different levels
+/// or field sizes can run on different threads at the same time.
+///
+struct GameContext
+{
+  ///
+  /// Take the loaded settings and the initial field size.
+  ///
+  static GameContext FromSettings();
+
+  GameParameters m_parameters;
+
+  QSize m_fieldSize;
+};
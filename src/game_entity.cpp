@@ -1,4 +1,5 @@
 #include "game_entity.hpp"
+#include "snapshot.hpp"
 
 GameEntity::~GameEntity() {}
 
@@ -15,6 +16,8 @@ QVector2D const & GameEntity::GetPosition() const
 void GameEntity::SetPosition(QVector2D const & point)
 {
   m_position = point;
+
+  UpdateBox();
 }
 
 const TSize & GameEntity::GetSize() const
@@ -25,25 +28,24 @@ const TSize & GameEntity::GetSize() const
 void GameEntity::SetSize(const TSize & size)
 {
   m_size = size;
-}
 
-std::shared_ptr<QOpenGLTexture> GameEntity::GetTexture()
-{
-  return m_texture;
+  UpdateBox();
 }
 
-void GameEntity::SetTexture(
-    std::shared_ptr<QOpenGLTexture> texture)
+void GameEntity::UpdateBox()
 {
-  m_texture = texture;
+  // The setters are used because createBox() rejects empty boxes.
+  m_box.setBoxMin(Point2D(m_position.x(), m_position.y()));
+  m_box.SetBoxMax(Point2D(m_position.x() + m_size.first,
+                          m_position.y() + m_size.second));
 }
 
-void GameEntity::IncreaseY(const float & value)
+void GameEntity::IncreaseY(float const & value, QSize const & fieldSize)
 {
   float tmp = m_position.y() + value;
 
   // Set top wall.
-  if (tmp > Globals::Height)
+  if (tmp > fieldSize.height())
   {
     m_position.setY(m_position.y() - 10.0f);
   }
@@ -51,9 +53,11 @@ void GameEntity::IncreaseY(const float & value)
   {
     m_position.setY(tmp);
   }
+
+  UpdateBox();
 }
 
-void GameEntity::DecreaseY(float const & value)
+void GameEntity::DecreaseY(float const & value, QSize const &)
 {
   float tmp = m_position.y() - value;
 
@@ -66,14 +70,16 @@ void GameEntity::DecreaseY(float const & value)
   {
     m_position.setY(tmp);
   }
+
+  UpdateBox();
 }
 
-void GameEntity::IncreaseX(float const &value)
+void GameEntity::IncreaseX(float const & value, QSize const & fieldSize)
 {
   float tmp = m_position.x() + value;
 
   // Set right wall.
-  if (tmp > Globals::Width)
+  if (tmp > fieldSize.width())
   {
     m_position.setX(m_position.x() - 10.0f);
   }
@@ -81,9 +87,11 @@ void GameEntity::IncreaseX(float const &value)
   {
     m_position.setX(tmp);
   }
+
+  UpdateBox();
 }
 
-void GameEntity::DecreaseX(float const &value)
+void GameEntity::DecreaseX(float const & value, QSize const &)
 {
 
   // Set left wall.
@@ -97,4 +105,24 @@ void GameEntity::DecreaseX(float const &value)
   {
     m_position.setX(tmp);
   }
+
+  UpdateBox();
+}
+
+void GameEntity::Save(Snapshot & snapshot) const
+{
+  snapshot.Write(m_position.x());
+  snapshot.Write(m_position.y());
+  snapshot.Write(m_size.first);
+  snapshot.Write(m_size.second);
+}
+
+void GameEntity::Restore(Snapshot & snapshot)
+{
+  m_position.setX(snapshot.Read<float>());
+  m_position.setY(snapshot.Read<float>());
+  snapshot.Read(m_size.first);
+  snapshot.Read(m_size.second);
+
+  UpdateBox();
 }
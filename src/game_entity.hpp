@@ -2,34 +2,42 @@
 
 #include <memory>
 #include <QVector2D>
-#include <QOpenGLTexture>
+#include <QSize>
 
 //#include "point2d.hpp"
 #include "box2d.hpp"
 
+class Snapshot;
+
 class GameEntity 
 {
 public:
-  GameEntity() = default;
+  GameEntity()
+  {
+    UpdateBox();
+  }
 
   GameEntity(std::string const & name)
     : m_name(name)
-  {}
+  {
+    UpdateBox();
+  }
 
   GameEntity(QVector2D const & position, std::string const & name)
     : m_position(position),
       m_name(name)
-  {}
+  {
+    UpdateBox();
+  }
 
   GameEntity(QVector2D const & position,
              std::string const & name,
-             std::shared_ptr<QImage> image,
              std::pair<int,int> const & size)
     : m_position(position),
       m_name(name),
       m_size(size)
   {
-    m_texture = std::make_shared<QOpenGLTexture>(*image);
+    UpdateBox();
   }
 
   //TODO Add copy constructor!
@@ -46,21 +54,43 @@ public:
   std::pair<int,int> const & GetSize() const;
   void SetSize(std::pair<int,int> const & size);
 
-  std::shared_ptr<QOpenGLTexture> GetTexture();
-  void SetTexture(std::shared_ptr<QOpenGLTexture> texture);
-
-  virtual void IncreaseY(float const & value);
-  virtual void DecreaseY(float const & value);
+  ///
+  /// The collision box (position, position + size).
+  ///
+  /// It is cached and updated when the position or the size changes,
+  /// so derived classes must call UpdateBox() after they change them.
+  ///
+  Box2D const & GetBox() const { return m_box; }
+
+  ///
+  /// Write the state of the entity to a snapshot.
+  ///
+  /// Derived classes append their own fields,
+  /// Restore() must read them in the same order.
+  ///
+  virtual void Save(Snapshot & snapshot) const;
+  virtual void Restore(Snapshot & snapshot);
 
-  virtual void IncreaseX(float const & value);
-  virtual void DecreaseX(float const & value);
-  
 protected:
+  ///
+  /// Move the entity inside the game field.
+  ///
+  /// Entities which move on their own make them public. Aliens don't,
+  /// they move only with their formation, see Formation::ApplyTo().
+  ///
+  virtual void IncreaseY(float const & value, QSize const & fieldSize);
+  virtual void DecreaseY(float const & value, QSize const & fieldSize);
+
+  virtual void IncreaseX(float const & value, QSize const & fieldSize);
+  virtual void DecreaseX(float const & value, QSize const & fieldSize);
+
+  void UpdateBox();
+
   QVector2D m_position;
   std::string m_name;
-  std::shared_ptr<QOpenGLTexture> m_texture = nullptr;
   //Width and Heigth
   std::pair<int,int> m_size;
+  Box2D m_box;
 };
 
 using TSize = std::pair<int, int>;
@@ -1,4 +1,5 @@
 #include "game_entity_with_weapon.hpp"
+#include "snapshot.hpp"
 
 uint GameEntityWithWeapon::GetRate() const
 {
@@ -34,3 +35,19 @@ BulletManager const & GameEntityWithWeapon::GetBulletManager() const
 {
   return m_bulletManager;
 }
+
+void GameEntityWithWeapon::Save(Snapshot & snapshot) const
+{
+  GameEntity::Save(snapshot);
+
+  snapshot.Write(m_rate);
+  snapshot.Write(m_health);
+}
+
+void GameEntityWithWeapon::Restore(Snapshot & snapshot)
+{
+  GameEntity::Restore(snapshot);
+
+  snapshot.Read(m_rate);
+  snapshot.Read(m_health);
+}
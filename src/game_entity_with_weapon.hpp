@@ -26,15 +26,17 @@ public:
                        std::string const & name,
                        uint const & rate,
                        int const & health,
-                       std::shared_ptr<QImage> image,
                        TSize const & size)
-    : GameEntity(position, name, image, size),
+    : GameEntity(position, name, size),
       m_rate(rate),
       m_health(health)
   {}
 
   ~GameEntityWithWeapon() override;
 
+  void Save(Snapshot & snapshot) const override;
+  void Restore(Snapshot & snapshot) override;
+
   uint GetRate() const;
   int GetHealth() const;
   BulletManager const & GetBulletManager() const;
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "bullet_parameters.hpp"
+#include "explosion_parameters.hpp"
+#include "alien_parameters.h"
+#include "star_parameters.h"
+#include "space_ship_parameters.h"
+#include "obstacle_parameters.h"
+#include "main_parameters.hpp"
+#include "wave_parameters.hpp"
+#include "texture_parameters.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+///
+/// Parameters of the game which are read from the settings file.
+///
+struct GameParameters
+{
+  /// Main parameters.
+  MainParameters m_mainParameters;
+
+  /// Star parameters.
+  StarParameters m_starParameters;
+
+  /// Explosion parameters.
+  ExplosionParameters m_explosionParameters;
+
+  /// Alien parameters.
+  AlienParameters m_alienParameters;
+
+  /// Bullet parameters.
+  BulletParameters m_bulletParameters;
+
+  /// Space Ship parameters.
+  SpaceShipParameters m_spaceShipParameters;
+
+  /// Obstacle parameters.
+  ObstacleParameters m_obstacleParameters;
+
+  /// Waves of the level. Without waves the aliens make one grid
+  /// from the alien parameters.
+  std::vector<WaveParameters> m_waves;
+
+  /// Texture upload by asset names. Missing assets use the defaults.
+  std::map<std::string, TextureParameters> m_textureParameters;
+};
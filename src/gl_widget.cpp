@@ -10,6 +10,7 @@
 #include <QDebug>
 
 #include <cmath>
+#include <cstdio>
 #include <iostream>
 
 #include "json/assertions.h"
@@ -25,14 +26,14 @@
 #include "except.hpp"
 #include "singleton.h"
 #include "settings.hpp"
+#include "culling.hpp"
+#include "memory_tracker.hpp"
 
 namespace
 {
 
-int constexpr kLeftDirection = 0;
-int constexpr kRightDirection = 1;
-int constexpr kUpDirection = 2;
-int constexpr kDownDirection = 3;
+// Don't try to catch up after long stalls.
+int constexpr kMaxTicksPerFrame = 5;
 
 bool IsLeftButton(Qt::MouseButtons buttons)
 {
@@ -61,24 +62,36 @@ GLWidget::GLWidget(GameWindow * parent,
                    size_t const & level)
   : m_mainWindow(parent),
     m_background(background),
-    m_level(level)
+    m_level(level),
+    m_world(level)
 {
-  m_space = std::make_shared<Space>();
-
   setMinimumSize(Globals::Width, Globals::Height);
+
+  // resize(0) keeps the reserved memory.
+  m_hudLine.reserve(256);
   setFocusPolicy(Qt::StrongFocus);
 
   connect(this, SIGNAL(gameOver(GameState, size_t)),
           parent, SLOT(gameOver(GameState, size_t)));
-
-  m_gameState = GameState::RUNINIG;
 }
 
 GLWidget::~GLWidget()
 {
+  m_simulation.reset();
+
   makeCurrent();
 
+  m_recorder.Stop();
+
+  m_particleRenderer.reset();
+
+  // Textures are released while their context is current.
+  m_textureManager.Clear();
+
   doneCurrent();
+
+  // The widget is deleted at the end of the game, nothing may keep its textures.
+  TextureManager::CheckLeaks();
 }
 
 void GLWidget::showEvent(QShowEvent * event)
@@ -95,6 +108,9 @@ void GLWidget::initializeGL()
   m_texturedRect = new TexturedRect();
   m_texturedRect->Initialize(this);
 
+  m_particleRenderer.reset(new ParticleRenderer());
+  m_particleRenderer->Initialize(this);
+
   std::string level = std::to_string(m_level);
 
   try
@@ -120,92 +136,53 @@ void GLWidget::initializeGL()
     throw InitialiseGameException();
   }
 
-  AddAliens();
+  m_inputLog.m_level = m_level;
+  m_inputLog.m_seed = Settings::Instance().m_mainParameters.m_seed;
+  // The game takes a copy of the settings, so it is created once they are loaded.
+  m_world = World(GameContext::FromSettings(), m_level);
+  m_world.Initialize();
 
-  AddSpaceShip();
+  m_jobSystem.reset(new JobSystem(Settings::Instance().m_mainParameters.m_jobThreads));
+  m_world.SetJobSystem(m_jobSystem.get());
 
-  AddObstacles();
+  m_inputLog.m_width = m_world.GetFieldSize().width();
+  m_inputLog.m_height = m_world.GetFieldSize().height();
 
-  AddStars();
+  m_textureManager.SetBudget(Settings::Instance().m_mainParameters.m_textureBudget * size_t(1024));
 
-  m_time.start();
-}
-
-void GLWidget::AddAliens()
-{
-  size_t aliensNumber = Settings::Instance().m_alienParameters.m_number;
-  int speed = Settings::Instance().m_alienParameters.m_speed;
-  int health = Settings::Instance().m_alienParameters.m_health;
-  TSize size = Settings::Instance().m_alienParameters.m_size;
-  size_t aliensRowNumber = Settings::Instance().m_alienParameters.m_rowNumber;
-  uint frequency = Settings::Instance().m_alienParameters.m_frequency;
-
-  int height = size.second;
-
-  size_t r = (Globals::Width / aliensNumber);
-
-  for (size_t j = 0; j < aliensRowNumber; j++)
+  // Every asset has its own upload settings.
+  auto const acquire = [this](RenderAsset asset, std::shared_ptr<QImage> const & image)
   {
-    for (size_t i = 0; i < aliensNumber; i++)
-    {
-      m_space->AddAlien(std::make_shared<Alien>(
-//<<<<<<< HEAD
-//                          speed,
-//                          QVector2D(i * r, 500 + j*height),
-//                          m_rateAlien,
-//                          health,
-//                          Images::Instance().GetImageAlien(),
-//                          size,
-//                          frequency));
-//=======
-          speed,
-          QVector2D(i * r, 600 + j*height),
-          Settings::Instance().m_alienParameters.m_rate,
-          health,
-          Images::Instance().GetImageAlien(),
-          size,
-          frequency));
-//>>>>>>> origin/develop
-    }
-  }
-}
+    auto const & textures = Settings::Instance().m_textureParameters;
+    auto const it = textures.find(TextureManager::GetName(asset));
 
-void GLWidget::AddSpaceShip()
-{  
-  int health = Settings::Instance().m_spaceShipParameters.m_health;
-  uint rate = Settings::Instance().m_spaceShipParameters.m_rate;
-  TSize size = Settings::Instance().m_spaceShipParameters.m_size;
-
-  m_space->SetSpaceShip(std::make_shared<SpaceShip>(
-                          QVector2D(Globals::Width / 2, size.second),
-                          rate,
-                          health,
-                          Images::Instance().GetImageSpaceShip(),
-                          size));
-}
+    m_textureManager.Acquire(asset, *image, it != textures.end() ? it->second : TextureParameters());
+  };
 
-void GLWidget::AddObstacles()
-{  
-  size_t obstaclesNumber = Settings::Instance().m_obstacleParameters.m_number;
-  int health = Settings::Instance().m_obstacleParameters.m_health;
-  TSize size = Settings::Instance().m_obstacleParameters.m_size;
+  Images & images = Images::Instance();
+  acquire(RenderAsset::Alien, images.GetImageAlien());
+  acquire(RenderAsset::SpaceShip, images.GetImageSpaceShip());
+  acquire(RenderAsset::Bullet, images.GetImageBullet());
+  acquire(RenderAsset::AlienBullet, images.GetImageBulletAlien());
+  acquire(RenderAsset::Obstacle, images.GetImageObstacle());
+  acquire(RenderAsset::Explosion, images.GetImageExplosion());
+  acquire(RenderAsset::Star, images.GetImageStar());
 
-  size_t width = Settings::Instance().m_obstacleParameters.m_width;
-
-  size_t r = (Globals::Width / obstaclesNumber);
-
-  for (size_t i = 0; i < obstaclesNumber; i++)
+  // The simulation thread needs the fixed step.
+  if (Settings::Instance().m_mainParameters.m_renderThread &&
+      Settings::Instance().m_mainParameters.m_fixedStep)
   {
-    m_space->AddObstacle(std::make_shared<Obstacle>(
-                           health,
-                           QVector2D(i*r + width, 300),
-                           Images::Instance().GetImageObstacle(),
-                           size));
+    m_simulation.reset(new SimulationThread(m_world));
+    m_simulation->Start();
   }
+
+  m_time.start();
 }
 
 void GLWidget::paintGL()
 {
+  MemoryScope scope(MemoryTag::Render);
+
   // Get time.
   int const elapsedMilliseconds = m_time.elapsed();
   int const elapsedMillisecondsFPS = m_timeFPS.elapsed();
@@ -216,7 +193,41 @@ void GLWidget::paintGL()
 
 //  qDebug() << "elapsedSeconds = " << elapsedSeconds;
 
-  Update(elapsedSeconds);
+  if (m_simulation == nullptr)
+  {
+    if (Settings::Instance().m_mainParameters.m_fixedStep)
+    {
+      m_accumulator += elapsedSeconds;
+
+      int ticks = 0;
+
+      while (m_accumulator >= World::kFixedTimeStep &&
+             ticks < kMaxTicksPerFrame &&
+             m_world.GetGameState() == GameState::RUNINIG)
+      {
+        m_world.Tick(World::kFixedTimeStep);
+
+        m_accumulator -= World::kFixedTimeStep;
+        ticks++;
+      }
+
+      if (ticks == kMaxTicksPerFrame)
+      {
+        m_accumulator = 0.0f;
+      }
+    }
+    else
+    {
+      m_world.Tick(elapsedSeconds);
+    }
+
+    m_renderList.Build(m_world);
+  }
+
+  // The newest finished step, the simulation goes on meanwhile.
+  RenderList const & renderList = m_simulation != nullptr
+      ? m_simulation->AcquireRenderList()
+      : m_renderList;
 
   QPainter painter;
   painter.begin(this);
@@ -235,42 +246,7 @@ void GLWidget::paintGL()
   glEnable(GL_BLEND);
   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-  IsGameOver();
-
-  ExplosionLogic();
-
-  // It throws an error.
-  CheckHitSpaceShip();
-
-  AlienLogic(elapsedSeconds);
-
-  CheckHitAlien();
-
-  ShotAlien();
-
-  SpaceShipBulletsLogic(elapsedSeconds);
-
-  AlienBulletsLogic(elapsedSeconds);
-
-  CheckHitObstacle();
-
-  CheckSpaceShipCollision();
-
-  RenderAlien();
-
-  RenderSpaceShip();
-
-  RenderBullet();
-
-  RenderObstacle();
-
-  RenderExplosion();
-
-  /// Set to zero if it reaches the 1.0 .
-
-  StarLogic();
-
-  RenderStar();
+  Render(renderList);
 
   // Free the resources.
   glDisable(GL_CULL_FACE);
@@ -280,22 +256,86 @@ void GLWidget::paintGL()
   // Print FPS to the screen.
   if (elapsedMilliseconds != 0)
   {
-    QString framesPerSecond;
-    QString score;
-    QString life;
+    // Lines are formatted on the stack and copied to one string
+    // which keeps its memory, so the HUD doesn't allocate every frame.
+    char line[256];
 
-    framesPerSecond.setNum(m_frames / elapsedSecondsFPS, 'f', 2);
+    auto const drawLine = [this, &painter, &line](int y)
+    {
+      m_hudLine.resize(0);
+      m_hudLine.append(QLatin1String(line));
+      painter.drawText(20, y, m_hudLine);
+    };
 
     painter.setPen(Qt::white);
 
-    int spaceShipHealth = m_space->GetSpaceShip()->GetHealth();
+    snprintf(line, sizeof(line), "%.2f fps", m_frames / elapsedSecondsFPS);
+    drawLine(40);
+    snprintf(line, sizeof(line), "score: %zu", renderList.m_score);
+    drawLine(60);
+    snprintf(line, sizeof(line), "life: %d", renderList.m_health);
+    drawLine(80);
+    snprintf(line, sizeof(line), "culled: %zu", m_culled);
+    drawLine(100);
+    snprintf(line, sizeof(line), "arena: %zu KB, %zu allocations, heap blocks: %llu",
+             renderList.m_arenaBytes / 1024, renderList.m_arenaAllocations,
+             static_cast<unsigned long long>(renderList.m_arenaHeapAllocations));
+    drawLine(120);
+
+    TextureStats const textures = TextureManager::GetTotal();
+    snprintf(line, sizeof(line), "textures: %zu, %zu KB of %zu KB",
+             textures.m_count, textures.m_bytes / 1024, m_textureManager.GetBudget() / 1024);
+    drawLine(140);
+
+    // Kilobytes of every asset.
+    int length = snprintf(line, sizeof(line), "  ");
+    for (size_t i = 0; i < static_cast<size_t>(RenderAsset::Count) && length < int(sizeof(line)); ++i)
+    {
+      RenderAsset const asset = static_cast<RenderAsset>(i);
+      TextureStats const stats = TextureManager::GetStats(asset);
+      length += snprintf(line + length, sizeof(line) - length, "%s: %zu/%zu KB ",
+                         TextureManager::GetName(asset), stats.m_count, stats.m_bytes / 1024);
+    }
+    drawLine(160);
+
+    int y = 180;
+
+    if (MemoryTracker::IsEnabled())
+    {
+      MemoryStats const total = MemoryTracker::GetTotal();
+      MemoryStats const space = MemoryTracker::GetStats(MemoryTag::Space);
+
+      // Allocations of the game logic per step since the last frame.
+      // The step counter starts over with a new level.
+      uint64_t const ticks = renderList.m_tick > m_memoryTick
+          ? renderList.m_tick - m_memoryTick
+          : 0;
+      double const rate = ticks > 0
+          ? static_cast<double>(space.m_allocations - m_memorySpaceAllocations) / ticks
+          : 0.0;
+
+      m_memoryTick = renderList.m_tick;
+      m_memorySpaceAllocations = space.m_allocations;
+
+      snprintf(line, sizeof(line), "heap: %lld KB, peak: %lld KB, space: %.1f allocations/tick",
+               static_cast<long long>(total.m_liveBytes / 1024),
+               static_cast<long long>(total.m_peakBytes / 1024), rate);
+      drawLine(y);
+      y += 20;
+    }
 
-    painter.drawText(20, 40, framesPerSecond + " fps");
-    painter.drawText(20, 60, "score: " + QString::number(m_score));
-    painter.drawText(20, 80, "life: " + QString::number(spaceShipHealth));
+    if (m_recorder.IsRecording())
+    {
+      snprintf(line, sizeof(line), "rec: %zu frames, dropped: %zu",
+               m_recorder.GetCapturedFrames(), m_recorder.GetDroppedFrames());
+      drawLine(y);
+    }
   }
   painter.end();
 
+  // Read back the finished frame including the HUD.
+  m_recorder.Capture();
+
   // Restart main timer.
   m_time.start();
 
@@ -310,350 +350,119 @@ void GLWidget::paintGL()
   ++m_frames;
 
   // Check the game state and decide what to do next.
-  if (m_gameState == GameState::RUNINIG)
+  if (renderList.m_gameState == GameState::RUNINIG)
   {
     update();
   }
   else
   {
-    emit gameOver(m_gameState, m_score);
-  }
-}
-
-void GLWidget::resizeGL(int w, int h)
-{
-  SetPosition(w, h);
-  m_screenSize.setWidth(w);
-  Globals::Width = w;
-  m_screenSize.setHeight(h);
-  Globals::Height = h;
-}
-
-void GLWidget::Update(float elapsedSeconds)
-{
-  float const kSpeed = Settings::Instance().m_spaceShipParameters.m_speed; // pixels per second.
-
-  if (m_directions[kUpDirection])
-  {
-    m_space->GetSpaceShip()->IncreaseY(kSpeed * elapsedSeconds);
-  }
-  if (m_directions[kDownDirection])
-  {
-    m_space->GetSpaceShip()->DecreaseY(kSpeed * elapsedSeconds);
-  }
-  if (m_directions[kLeftDirection])
-  {
-    m_space->GetSpaceShip()->DecreaseX(kSpeed * elapsedSeconds);
-  }
-  if (m_directions[kRightDirection])
-  {
-    m_space->GetSpaceShip()->IncreaseX(kSpeed * elapsedSeconds);
-  }
-}
-
-void GLWidget::IsGameOver()
-{
-  if (m_space->GetSpaceShip()->GetHealth() <= 0)
-  {
-    m_gameState = GameState::LOSE;
-  }
-  else
-  {
-    std::list<TAlienPtr> & lstAlien = m_space->GetAliens();
-
-    if (lstAlien.empty())
+    // The world belongs to this thread again.
+    if (m_simulation != nullptr)
     {
-      m_gameState = GameState::WIN;
+      m_simulation->Stop();
     }
-  }
-}
 
-void GLWidget::RenderAlien()
-{
-  for (auto alien : m_space->GetAliens())
-  {
-    m_texturedRect->Render(alien->GetTexture(),
-                           alien->GetPosition(),
-                           alien->GetSize(),
-                           m_screenSize,
-                           1.0);
+    SaveInputLog();
+
+    emit gameOver(m_world.GetGameState(), m_world.GetScore());
   }
 }
 
-void GLWidget::RenderSpaceShip()
+void GLWidget::resizeGL(int w, int h)
 {
-  m_texturedRect->Render(m_space->GetSpaceShip()->GetTexture(),
-                         m_space->GetSpaceShip()->GetPosition(),
-                         m_space->GetSpaceShip()->GetSize(),
-                         m_screenSize,
-                         1.0);
-}
+  // A stream can't change its frame size.
+  m_recorder.Stop();
 
-void GLWidget::RenderBullet()
-{
-  for (auto bullet : m_space->GetSpaceShipBullets())
-  {
-    m_texturedRect->Render(bullet->GetTexture(),
-                           bullet->GetPosition(),
-                           bullet->GetSize(),
-                           m_screenSize,
-                           1.0);
-  }
-  for (auto bullet : m_space->GetAlienBullets())
-  {
-    m_texturedRect->Render(bullet->GetTexture(),
-                           bullet->GetPosition(),
-                           bullet->GetSize(),
-                           m_screenSize,
-                           1.0);
-  }
-}
+  InputCommand command;
+  command.m_action = InputAction::Resize;
+  command.m_width = w;
+  command.m_height = h;
+  ApplyCommand(command);
 
-void GLWidget::RenderObstacle()
-{
-  for (auto obstacle : m_space->GetObstacles())
-  {
-    m_texturedRect->Render(obstacle->GetTexture(),
-                           obstacle->GetPosition(),
-                           obstacle->GetSize(),
-                           m_screenSize,
-                           1.0);
-  }
+  m_screenSize.setWidth(w);
+  m_screenSize.setHeight(h);
 }
 
-void GLWidget::RenderStar()
+void GLWidget::ApplyCommand(InputCommand const & command)
 {
-  int i=0;
-
-  for (auto it = m_space->GetStars().begin();
-       it != m_space->GetStars().end() || i <m_random.size();
-       ++it, i++)
+  RunOnWorld([this, command](World & world)
   {
-    float blend = static_cast<float>(sin(m_random.at(i).m_periodStar * 2 * PI));
-    m_texturedRect->Render(
-          (*it)->GetTexture(),
-          QVector2D(m_random.at(i).m_randomStar.first*Globals::Width,
-                    m_random.at(i).m_randomStar.second*Globals::Height),
-          (*it)->GetSize(),
-          m_screenSize,
-          blend);
-  }
+    // Events come between the simulation steps,
+    // so the command acts right before the next step.
+    m_inputLog.Add(world.GetTick(), command);
+
+    world.Apply(command);
+  });
 }
 
-void GLWidget::RenderExplosion()
+void GLWidget::RunOnWorld(SimulationThread::TTask const & task)
 {
-  for (auto explosion : m_space->GetExplosions())
+  if (m_simulation != nullptr && m_simulation->IsRunning())
   {
-    m_texturedRect->Render(explosion->GetTexture(),
-                           explosion->GetPosition(),
-                           explosion->GetSize(),
-                           m_screenSize,
-                           1.0);
+    m_simulation->Post(task);
   }
-}
-
-void GLWidget::AddStars()
-{
-  size_t starsNumber = Settings::Instance().m_starParameters.m_number;
-  TSize size = Settings::Instance().m_starParameters.m_size;
-
-  for (size_t i = 1; i <= starsNumber; i++)
+  else
   {
-    m_space->AddStar(std::make_shared<Star>(
-                       QVector2D(200, 600),
-                       Images::Instance().GetImageStar(),
-                       size));
-
-    RandomStar randomStar;
-    randomStar.m_periodStar = Random(0.0f, 1.0f);
-    randomStar.m_randomStar = std::make_pair(Random(0.0f, 1.0f), Random(0.0f, 1.0f));
-    m_random.push_back(randomStar);
+    task(m_world);
   }
 }
 
-void GLWidget::CheckHitSpaceShip()
+void GLWidget::SaveInputLog()
 {
-  QVector2D positionSpaceShip = m_space->GetSpaceShip()->GetPosition();
-
-  TSize sizeSpaceShip = m_space->GetSpaceShip()->GetSize();
-
-  Box2D spaceShipBox = Box2D::createBox(
-        Point2D(positionSpaceShip.x(), positionSpaceShip.y()),
-        Point2D(positionSpaceShip.x() + sizeSpaceShip.first,
-                positionSpaceShip.y() + sizeSpaceShip.second));
-
-  std::list<TBulletPtr> & lstBullet = m_space->GetAlienBullets();
-
-  for (auto it = begin(lstBullet); it != end(lstBullet);)
+  // A variable time step can't be replayed.
+  if (m_isInputLogSaved ||
+      !Settings::Instance().m_mainParameters.m_fixedStep ||
+      !Settings::Instance().m_mainParameters.m_recordReplay)
   {
-    QVector2D position = (*it)->GetPosition();
-
-    TSize size = (*it)->GetSize();
-
-    Box2D bulletBox = Box2D::createBox(
-          Point2D(position.x(), position.y()),
-          Point2D(position.x() + size.first,
-                  position.y() + size.second));
-
-    // If two boxes are not intersected with each other
-    // then return false.
-    if (Box2D::checkBoxes(spaceShipBox,bulletBox))
-    {
-      KillSpaceShip((*it)->GetDamage(),(*it)->GetPosition());
-      it = lstBullet.erase(it);
-    }
-    else
-    {
-      ++it;
-    }
+    return;
   }
-}
 
-void GLWidget::KillSpaceShip(uint damage, QVector2D const position)
-{
-  int health = m_space->GetSpaceShip()->GetHealth();
+  m_isInputLogSaved = true;
 
-  int health_updated = health - damage;
+  m_inputLog.m_finalTick = m_world.GetTick();
+  m_inputLog.m_finalScore = m_world.GetScore();
+  m_inputLog.m_finalState = m_world.GetGameState();
+  m_inputLog.m_finalHash = m_world.GetHistoryHash();
 
-  if (health_updated > 0)
+  try
   {
-    m_space->AddExplosion(std::make_shared<Explosion>(
-                           position,
-                           Images::Instance().GetImageExplosion(),
-                           Settings::Instance().m_explosionParameters.m_sizeBig,
-                           Settings::Instance().m_explosionParameters.m_lifetimeBig));
-
-    m_space->GetSpaceShip()->SetHealth(health_updated);
+    m_inputLog.Write("level_" + std::to_string(m_level) + ".replay");
   }
-  else
+  catch (WriteFileException const & ex)
   {
-    m_gameState = GameState::LOSE;
+    qDebug() << ex.what();
   }
 }
 
-void GLWidget::CheckHitAlien()
+void GLWidget::Render(RenderList const & renderList)
 {
-  std::list<TBulletPtr> & lstBullet = m_space->GetSpaceShipBullets();
-  std::list<TAlienPtr> & lstAlien = m_space->GetAliens();
+  m_culled = 0;
 
-  for (auto itAlien = begin(lstAlien); itAlien != end(lstAlien);)
+  for (auto const & item : renderList.m_items)
   {
-    QVector2D positionAlien = (*itAlien)->GetPosition();
-
-    TSize sizeAlien = (*itAlien)->GetSize();
-
-    Box2D alienBox = Box2D::createBox(
-          Point2D(positionAlien.x(), positionAlien.y()),
-          Point2D(positionAlien.x() + sizeAlien.first,
-                  positionAlien.y() + sizeAlien.second));
-//    LOG(LogLevel::info) << alienBox;
-    bool flag = false;
-
-    for (auto it = begin(lstBullet); it != end(lstBullet);)
-    {
-      QVector2D position = (*it)->GetPosition();
-
-      TSize size = (*it)->GetSize();
-
-      Box2D bulletBox = Box2D::createBox(
-            Point2D(position.x(), position.y()),
-            Point2D(position.x() + size.first,
-                    position.y() + size.second));
-
-      // If two boxes are not intersected with each other
-      // then return false.
-      if (Box2D::checkBoxes(alienBox,bulletBox))
-      {
-        int health = (*itAlien)->GetHealth();
-
-        uint damage = (*it)->GetDamage();
-
-        int health_updated = health - damage;
-
-        if (health_updated > 0)
-        {
-          m_space->AddExplosion(std::make_shared<Explosion>(
-                                 positionAlien,
-                                 Images::Instance().GetImageExplosion(),
-                                 Settings::Instance().m_explosionParameters.m_size,
-                                 Settings::Instance().m_explosionParameters.m_lifetime));
-
-          (*itAlien)->SetHealth(health_updated);
-        }
-        else
-        {
-          flag = true;
-        }
-        it = lstBullet.erase(it);
-      }
-      else
-      {
-        ++it;
-      }
-    }
-
-//    qDebug()<<"lstBullet.size()="<<lstBullet.size();
-
-    if (flag)
-    {
-      m_space->AddExplosion(std::make_shared<Explosion>(
-                             positionAlien,
-                             Images::Instance().GetImageExplosion(),
-                             Settings::Instance().m_explosionParameters.m_sizeBig,
-                             Settings::Instance().m_explosionParameters.m_lifetimeBig));
-
-      itAlien = lstAlien.erase(itAlien);
-
-      m_score += Settings::Instance().m_alienParameters.m_score;
-    }
-    else
-    {
-      ++itAlien;
-    }
+    RenderItem(item);
   }
 
-//  qDebug() <<"lstAlien.size() = " <<lstAlien.size();
-
+  // Explosions.
+  m_particleRenderer->Render(m_textureManager.Get(RenderAsset::Explosion),
+                             renderList.m_particles,
+                             renderList.m_particleTime,
+                             m_screenSize);
 }
 
-void GLWidget::ShotAlien()
+void GLWidget::RenderItem(DrawItem const & item)
 {
-  std::list<TAlienPtr> & lst = m_space->GetAliens();
-
-  for (auto it = begin(lst); it != end(lst); ++it)
+  if (!Culling::IsVisible(item.m_position, item.m_size, m_screenSize))
   {
-    if (abs(m_space->GetSpaceShip()->GetPosition().x()
-                - (*it)->GetPosition().x()) < Globals::Width / 2 && Random(0.0f, 1.0f) <= 0.5f)
-    {
-      if ((*it)->Shot())
-      {
-        std::shared_ptr<Bullet> bullet = std::make_shared<Bullet>(
-              (*it)->GetPosition(),
-              Images::Instance().GetImageBulletAlien(),
-              Settings::Instance().m_bulletParameters.m_damage,
-              Settings::Instance().m_bulletParameters.m_size);
-
-        m_space->AddAlienBullet(bullet);
-      }
-    }
+    ++m_culled;
+    return;
   }
-}
-
-void GLWidget::ExplosionLogic()
-{
-  std::list<TExplosionPtr> & lst = m_space->GetExplosions();
 
-  for (auto it = begin(lst); it != end(lst);)
-  {
-    if ((*it)->ReduceLifeTime())
-    {
-      it = lst.erase(it);
-    }
-    else
-    {
-      ++it;
-    }
-  }
+  m_texturedRect->Render(m_textureManager.Get(item.m_asset),
+                         item.m_position,
+                         item.m_size,
+                         m_screenSize,
+                         item.m_blend);
 }
 
 void GLWidget::mousePressEvent(QMouseEvent * e)
@@ -720,388 +529,155 @@ void GLWidget::wheelEvent(QWheelEvent * e)
 
 void GLWidget::keyPressEvent(QKeyEvent * e)
 {
+  // Auto repeated events don't change the key state.
+  if (e->isAutoRepeat() && e->key() != Qt::Key_Space)
+  {
+    return;
+  }
+
+  InputCommand command;
+  command.m_isPressed = true;
+
   // Exit to menu.
   if (e->key() == Qt::Key_Escape)
   {
-    m_gameState = GameState::MENU;
+    command.m_action = InputAction::Menu;
+    ApplyCommand(command);
   }
 
   // Cheat code.
   // Backspace button kills all enemies.
   if (e->key() == Qt::Key_Backspace)
   {
-    std::list<TAlienPtr> & lstAlien = m_space->GetAliens();
-    std::list<TObstaclePtr> & lstObstacles = m_space->GetObstacles();
-
-    if (!lstAlien.empty())
-    {
-      m_score += lstAlien.size() * Settings::Instance().m_alienParameters.m_score;
-      m_score += lstObstacles.size() * Settings::Instance().m_obstacleParameters.m_score;
-
-      lstAlien.clear();
-    }
+    command.m_action = InputAction::KillAliens;
+    ApplyCommand(command);
   }
 
-  if (e->key() == Qt::Key_Up)
+  // Quick save.
+  if (e->key() == Qt::Key_F5)
   {
-    m_directions[kUpDirection] = true;
-  }
-  else if (e->key() == Qt::Key_Down)
-  {
-    m_directions[kDownDirection] = true;
+    RunOnWorld([this](World & world)
+    {
+      m_quickSave.Clear();
+      world.Save(m_quickSave);
+    });
   }
-  else if (e->key() == Qt::Key_Left)
+
+  // Quick load.
+  if (e->key() == Qt::Key_F7)
   {
-    m_directions[kLeftDirection] = true;
+    RunOnWorld([this](World & world)
+    {
+      if (m_quickSave.Size() == 0)
+      {
+        return;
+      }
+
+      try
+      {
+        world.Restore(m_quickSave);
+
+        // The log can't reproduce the session any more.
+        m_isInputLogSaved = true;
+      }
+      catch (ReadSnapshotException const & ex)
+      {
+        qDebug() << ex.what();
+      }
+    });
   }
-  else if (e->key() == Qt::Key_Right)
+
+  // Record frames to a raw video stream.
+  if (e->key() == Qt::Key_F9)
   {
-    m_directions[kRightDirection] = true;
+    ToggleRecording(FrameRecorder::Format::Y4M, "capture.y4m");
   }
-  else if (e->key() == Qt::Key_Space)
-  {
-    std::shared_ptr<Bullet> bullet = std::make_shared<Bullet>(
-          m_space->GetSpaceShip()->GetPosition(),
-          Images::Instance().GetImageBullet(),
-          Settings::Instance().m_bulletParameters.m_damage,
-          Settings::Instance().m_bulletParameters.m_size);
 
-    m_space->AddSpaceShipBullet(bullet);
+  // Record frames to an image sequence.
+  if (e->key() == Qt::Key_F10)
+  {
+    ToggleRecording(FrameRecorder::Format::ImageSequence, "capture");
   }
-}
 
-void GLWidget::keyReleaseEvent(QKeyEvent * e)
-{
   if (e->key() == Qt::Key_Up)
   {
-    m_directions[kUpDirection] = false;
+    command.m_action = InputAction::Up;
+    ApplyCommand(command);
   }
   else if (e->key() == Qt::Key_Down)
   {
-    m_directions[kDownDirection] = false;
+    command.m_action = InputAction::Down;
+    ApplyCommand(command);
   }
   else if (e->key() == Qt::Key_Left)
   {
-    m_directions[kLeftDirection] = false;
+    command.m_action = InputAction::Left;
+    ApplyCommand(command);
   }
   else if (e->key() == Qt::Key_Right)
   {
-    m_directions[kRightDirection] = false;
+    command.m_action = InputAction::Right;
+    ApplyCommand(command);
   }
-}
-
-float GLWidget::Random(float min, float max)
-{
-  std::uniform_real_distribution<double> distribution(min, max);
-
-  double number = distribution(m_generator);
-
-  return number;
-}
-
-void GLWidget::SpaceShipBulletsLogic(float const & elapsedSeconds)
-{
-  // Loop over space ship bullets and delete it if needed.
-  std::list<TBulletPtr> & lst = m_space->GetSpaceShipBullets();
-
-  uint rate = m_space->GetSpaceShip()->GetRate();
-
-  for (auto it = begin(lst); it != end(lst);)
+  else if (e->key() == Qt::Key_Space)
   {
-    (*it)->IncreaseY(elapsedSeconds * rate);
-
-    if ((*it)->GetPosition().y() > Globals::Height)
-    {
-      it = lst.erase(it);
-    }
-    else
-    {
-      ++it;
-    }
+    command.m_action = InputAction::Fire;
+    ApplyCommand(command);
   }
-
-  // Check if needed.
-  //  qDebug() << "lst.size() = " << lst.size();
 }
 
-void GLWidget::AlienBulletsLogic(float const & elapsedSeconds)
+void GLWidget::keyReleaseEvent(QKeyEvent * e)
 {
-  // Loop over space ship bullets and delete it if needed.
-  std::list<TBulletPtr> & lst = m_space->GetAlienBullets();
-
-  for (auto it = begin(lst); it != end(lst);)
+  if (e->isAutoRepeat())
   {
-    (*it)->DecreaseY(elapsedSeconds * Settings::Instance().m_alienParameters.m_rate);
-
-    if ((*it)->GetPosition().y() == 0.0f)
-    {
-      it = lst.erase(it);
-    }
-    else
-    {
-      ++it;
-    }
+    return;
   }
 
-  // Check if needed.
-  //  qDebug() << "lst.size() = " << lst.size();
-}
-
-void GLWidget::AlienLogic(float const & elapsedSeconds)
-{
-  // Loop over aliens.
-  std::list<TAlienPtr> & lst = m_space->GetAliens();
+  InputCommand command;
+  command.m_isPressed = false;
 
-  for (auto itAlien : lst)
+  if (e->key() == Qt::Key_Up)
   {
-    if (itAlien->GetSpeed() > 0)
-    {
-      itAlien->IncreaseX(elapsedSeconds * (itAlien->GetAbsoluteSpeed()));
-    }
-    else
-    {
-      itAlien->DecreaseX(elapsedSeconds * (itAlien->GetAbsoluteSpeed()));
-    }
+    command.m_action = InputAction::Up;
+    ApplyCommand(command);
   }
-}
-
-void GLWidget::CheckHitObstacle()
-{
-  std::list<TObstaclePtr > & lstObstacles = m_space->GetObstacles();
-
-  std::list<TBulletPtr> & lstBulletsAlien = m_space->GetAlienBullets();
-
-  std::list<TBulletPtr> & lstBulletsSpaceShip = m_space->GetSpaceShipBullets();
-
-  // Loop over obstacles.
-  for (auto itObstacle = begin(lstObstacles); itObstacle != end(lstObstacles);)
+  else if (e->key() == Qt::Key_Down)
   {
-    QVector2D positionObstacle = (*itObstacle)->GetPosition();
-
-    TSize sizeObstacle = (*itObstacle)->GetSize();
-
-    Box2D obstacleBox = Box2D::createBox(
-        Point2D(positionObstacle.x(), positionObstacle.y()),
-        Point2D(positionObstacle.x() + sizeObstacle.first,
-                positionObstacle.y() + sizeObstacle.second));
-
-    bool flag = false;
-
-    // Loop over alien bullets.
-    for (auto it = begin(lstBulletsAlien); it != end(lstBulletsAlien); ++it)
-    {
-      QVector2D position = (*it)->GetPosition();
-
-      TSize size = (*it)->GetSize();
-
-      Box2D bulletBox = Box2D::createBox(
-          Point2D(position.x(), position.y()),
-          Point2D(position.x() + size.first,
-                  position.y() + size.second));
-
-      // If two boxes are not intersected with each other
-      // then return false.
-      if (Box2D::checkBoxes(obstacleBox, bulletBox))
-      {
-        int health = (*itObstacle)->GetHealth();
-
-        uint damage = (*it)->GetDamage();
-
-        int health_updated = health - damage;
-
-        if (health_updated > 0)
-        {
-          m_space->AddExplosion(std::make_shared<Explosion>(
-                                 positionObstacle,
-                                 Images::Instance().GetImageExplosion(),
-                                 Settings::Instance().m_explosionParameters.m_size,
-                                 Settings::Instance().m_explosionParameters.m_lifetime));
-
-          (*itObstacle)->SetHealth(health_updated);
-        }
-        else
-        {
-           flag = true;
-        }
-        it = lstBulletsAlien.erase(it);
-        break;
-      }
-    }
-
-    // Loop over space ship bullets if needed.
-    if (!flag)
-    {
-      for (auto it = begin(lstBulletsSpaceShip); it != end(lstBulletsSpaceShip); ++it)
-      {
-        QVector2D position = (*it)->GetPosition();
-
-        TSize size = (*it)->GetSize();
-
-        Box2D bulletBox = Box2D::createBox(
-            Point2D(position.x(), position.y()),
-            Point2D(position.x() + size.first,
-                    position.y() + size.second));
-
-        // If two boxes are not intersected with each other
-        // then return false.
-        if (Box2D::checkBoxes(obstacleBox, bulletBox))
-        {
-          int health = (*itObstacle)->GetHealth();
-
-          uint damage = (*it)->GetDamage();
-
-          int health_updated = health - damage;
-
-          if (health_updated > 0)
-          {
-            m_space->AddExplosion(std::make_shared<Explosion>(
-                                   positionObstacle,
-                                   Images::Instance().GetImageExplosion(),
-                                   Settings::Instance().m_explosionParameters.m_size,
-                                   Settings::Instance().m_explosionParameters.m_lifetime));
-
-            (*itObstacle)->SetHealth(health_updated);
-          }
-          else
-          {
-             flag = true;
-          }
-          it = lstBulletsAlien.erase(it);
-          break;
-        }
-      }
-    }
-
-    // Make explosion if needed.
-    if (flag)
-    {
-      m_space->AddExplosion(std::make_shared<Explosion>(
-          positionObstacle,
-          Images::Instance().GetImageExplosion(),
-          Settings::Instance().m_explosionParameters.m_sizeBig,
-          Settings::Instance().m_explosionParameters.m_lifetimeBig));
-
-      itObstacle = lstObstacles.erase(itObstacle);
-
-      m_score += Settings::Instance().m_obstacleParameters.m_score;
-    }
-    else
-    {
-      ++itObstacle;
-    }
+    command.m_action = InputAction::Down;
+    ApplyCommand(command);
   }
-}
-
-void GLWidget::StarLogic()
-{
-  for (auto it = m_random.begin() ; it != m_random.end(); ++it)
+  else if (e->key() == Qt::Key_Left)
   {
-    if((*it).m_periodStar < 1.0)
-    {
-      (*it).m_periodStar += 0.001f;
-    }
-    else
-    {
-      (*it).m_randomStar = std::make_pair(Random(0.0f, 1.0f), Random(0.0f, 1.0f));
-      (*it).m_periodStar = 0.0f;
-    }
+    command.m_action = InputAction::Left;
+    ApplyCommand(command);
+  }
+  else if (e->key() == Qt::Key_Right)
+  {
+    command.m_action = InputAction::Right;
+    ApplyCommand(command);
   }
 }
 
-void GLWidget::SetPosition(int w, int h)
+void GLWidget::ToggleRecording(FrameRecorder::Format format,
+                               std::string const & path)
 {
-  QVector2D position = m_space->GetSpaceShip()->GetPosition();
-  m_space->GetSpaceShip()->SetPosition(QVector2D(position.x()*w/Globals::Width,position.y()*h/Globals::Height));
+  // Pixel buffers are created and destroyed in the widget context.
+  makeCurrent();
 
-  for (auto obstacle : m_space->GetObstacles())
+  if (m_recorder.IsRecording())
   {
-    position = obstacle->GetPosition();
-    obstacle->SetPosition(QVector2D(position.x()*w/Globals::Width,position.y()*h/Globals::Height));
-  }
+    m_recorder.Stop();
 
-  for (auto alien : m_space->GetAliens())
-  {
-    position = alien->GetPosition();
-    alien->SetPosition(QVector2D(position.x()*w/Globals::Width,position.y()*h/Globals::Height));
+    return;
   }
 
-  for (auto bullet : m_space->GetAlienBullets())
+  try
   {
-    position = bullet->GetPosition();
-    bullet->SetPosition(QVector2D(position.x()*w/Globals::Width,position.y()*h/Globals::Height));
+    m_recorder.Start(this, m_screenSize, path, format);
   }
-
-  for (auto bullet : m_space->GetSpaceShipBullets())
+  catch (WriteFileException const & ex)
   {
-    position = bullet->GetPosition();
-    bullet->SetPosition(QVector2D(position.x()*w/Globals::Width,position.y()*h/Globals::Height));
+    qDebug() << ex.what();
   }
 }
 
-void GLWidget::CheckSpaceShipCollision()
-{
-  QVector2D positionSpaceShip = m_space->GetSpaceShip()->GetPosition();
-
-  TSize sizeSpaceShip = m_space->GetSpaceShip()->GetSize();
-
-  Box2D spaceShipBox = Box2D::createBox(
-        Point2D(positionSpaceShip.x(), positionSpaceShip.y()),
-        Point2D(positionSpaceShip.x() + sizeSpaceShip.first,
-                positionSpaceShip.y() + sizeSpaceShip.second));
-
-  std::list<TObstaclePtr > & lstObstacles = m_space->GetObstacles();
-
-  // Loop over obstacles.
-  for (auto itObstacle = begin(lstObstacles); itObstacle != end(lstObstacles);)
-  {
-    QVector2D positionObstacle = (*itObstacle)->GetPosition();
-
-    TSize sizeObstacle = (*itObstacle)->GetSize();
-
-    Box2D obstacleBox = Box2D::createBox(
-        Point2D(positionObstacle.x(), positionObstacle.y()),
-        Point2D(positionObstacle.x() + sizeObstacle.first,
-                positionObstacle.y() + sizeObstacle.second));
-
-    // If two boxes are not intersected with each other
-    // then return false.
-    if (Box2D::checkBoxes(spaceShipBox, obstacleBox))
-    {
-      m_space->GetSpaceShip()->SetHealth(0);
-
-      itObstacle = lstObstacles.erase(itObstacle);
-    }
-    else
-    {
-      ++itObstacle;
-    }
-  }
-
-  std::list<TAlienPtr > & lstAliens = m_space->GetAliens();
-
-  // Loop over aliens.
-  for (auto itAlien = begin(lstAliens); itAlien != end(lstAliens);)
-  {
-    QVector2D positionAlien = (*itAlien)->GetPosition();
-
-    TSize sizeAlien = (*itAlien)->GetSize();
-
-    Box2D alienBox = Box2D::createBox(
-        Point2D(positionAlien.x(), positionAlien.y()),
-        Point2D(positionAlien.x() + sizeAlien.first,
-                positionAlien.y() + sizeAlien.second));
-
-    // If two boxes are not intersected with each other
-    // then return false.
-    if (Box2D::checkBoxes(spaceShipBox, alienBox))
-    {
-      m_space->GetSpaceShip()->SetHealth(0);
-
-      itAlien = lstAliens.erase(itAlien);
-    }
-    else
-    {
-      ++itAlien;
-    }
-  }
-}
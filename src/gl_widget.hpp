@@ -5,7 +5,6 @@
 #include <QTime>
 
 #include <array>
-#include <random>
 #include <memory>
 
 #include "textured_rect.hpp"
@@ -13,8 +12,14 @@
 #include "space.hpp"
 #include "unordered_map"
 #include "images.hpp"
-#include "explosion.hpp"
+#include "particle_renderer.hpp"
 #include "game_state.hpp"
+#include "frame_recorder.hpp"
+#include "world.hpp"
+#include "input_log.hpp"
+#include "render_list.hpp"
+#include "simulation_thread.hpp"
+#include "texture_manager.hpp"
 
 class GameWindow;
 
@@ -24,12 +29,6 @@ QT_FORWARD_DECLARE_CLASS(QOpenGLTexture)
 QT_FORWARD_DECLARE_CLASS(QOpenGLShader)
 QT_FORWARD_DECLARE_CLASS(QOpenGLShaderProgram)
 
-struct RandomStar
-{
-  std::pair<float,float> m_randomStar;
-  float m_periodStar;
-};
-
 class GLWidget : public QGLWidget, protected QOpenGLFunctions
 {
   Q_OBJECT
@@ -51,11 +50,6 @@ protected:
   void paintGL() override;
   void initializeGL() override;
 
-  void Update(float elapsedSeconds);
-
-  /// Set m_isGameOver to true if game is over.
-  void IsGameOver();
-
   /// Mouse and keyboard events.
   void mousePressEvent(QMouseEvent * e) override;
   void mouseDoubleClickEvent(QMouseEvent * e) override;
@@ -65,41 +59,37 @@ protected:
   void keyPressEvent(QKeyEvent * e) override;
   void keyReleaseEvent(QKeyEvent * e) override;
 
-  /// Create objects.
-  void AddObstacles();
-  void AddSpaceShip();
-  void AddAliens();
-  void AddStars();
-
   /// Render stage.
-  void RenderAlien();
-  void RenderSpaceShip();
-  void RenderBullet();
-  void RenderObstacle();
-  void RenderStar();
-  void RenderExplosion();
-
-  /// Logic stage.
-  void CheckHitAlien();
-  void CheckHitSpaceShip();
-  void KillSpaceShip(uint damage, QVector2D const position);
-  void SpaceShipBulletsLogic(float const & elapsedSeconds);
-  void AlienBulletsLogic(float const & elapsedSeconds);
-  void AlienLogic(float const & elapsedSeconds);
-  void ShotAlien();
-  void ExplosionLogic();
-  void CheckHitObstacle();
-  void StarLogic();
-  void SetPosition(int w, int h);
-  void CheckSpaceShipCollision();
+  void Render(RenderList const & renderList);
 
   ///
-  /// Generate random number between min and max values.
+  /// Render an item if it is visible on the screen.
   ///
-  /// Look here for more info:
-  /// http://www.cplusplus.com/reference/random/uniform_real_distribution/
+  /// Otherwise it increases the culled entities counter.
   ///
-  float Random(float min, float max);
+  void RenderItem(DrawItem const & item);
+
+  ///
+  /// Run a task with the world. With the simulation thread
+  /// the task is queued and runs before the next step.
+  ///
+  void RunOnWorld(SimulationThread::TTask const & task);
+
+  ///
+  /// Apply a player command and record it.
+  ///
+  void ApplyCommand(InputCommand const & command);
+
+  ///
+  /// Store the recorded session to a file.
+  ///
+  void SaveInputLog();
+
+  ///
+  /// Start or stop recording of the rendered frames.
+  ///
+  void ToggleRecording(FrameRecorder::Format format,
+                       std::string const & path);
 
 private:
   int L2D(int px) const { return px * devicePixelRatio(); }
@@ -115,17 +105,44 @@ private:
   // The current level number.
   size_t m_level = 0;
 
-  std::vector<RandomStar> m_random;
+  World m_world;
+
+  // It runs independent stages of the game logic in parallel.
+  std::unique_ptr<JobSystem> m_jobSystem;
 
-  std::shared_ptr<Space> m_space = nullptr;
+  // Runs the world if the render thread is separated. It must be destroyed before the world.
+  std::unique_ptr<SimulationThread> m_simulation;
+
+  // The state which is drawn when the world runs on the GUI thread.
+  RenderList m_renderList;
+
+  // One texture per image.
+  TextureManager m_textureManager;
 
   TexturedRect * m_texturedRect = nullptr;
 
-  std::array<bool, 4> m_directions = {{ false, false, false, false }};
+  std::unique_ptr<ParticleRenderer> m_particleRenderer;
+
+  // Time which isn't simulated yet in the fixed step mode.
+  float m_accumulator = 0.0f;
+
+  // Commands of the session. It is used to replay the game.
+  // While the simulation thread runs, it is used only by that thread.
+  InputLog m_inputLog;
+  bool m_isInputLogSaved = false;
+
+  // Number of entities skipped by the culling stage in the last frame.
+  size_t m_culled = 0;
+
+  FrameRecorder m_recorder;
 
-  std::default_random_engine m_generator;
+  // Text of one HUD line.
+  QString m_hudLine;
 
-  GameState m_gameState = GameState::STOP;
+  // The step and the allocations of the game logic at the last frame.
+  uint64_t m_memoryTick = 0;
+  uint64_t m_memorySpaceAllocations = 0;
 
-  size_t m_score = 0;
+  // The game state stored by the quick save key. It is used with the world.
+  Snapshot m_quickSave;
 };
@@ -3,9 +3,12 @@
 #include <QDebug>
 
 #include "except.hpp"
+#include "memory_tracker.hpp"
 
 void Images::LoadImages()
 {
+  MemoryScope scope(MemoryTag::Images);
+
   std::string imageAlienPath = "data/alien.png";
   std::string imageStarPath = "data/star.png";
   std::string imageSpaceShipPath = "data/space_ship.png";
@@ -55,14 +58,22 @@ std::shared_ptr<QImage> Images::GetImageExplosion()
 
 std::shared_ptr<QImage> Images::LoadImage(std::string path)
 {
-  auto image = std::make_shared<QImage>(path.c_str());
+  QImage loaded(path.c_str());
 
-  if (image->isNull())
+  if (loaded.isNull())
   {
     throw LoadImagesException(path);
   }
 
-  return image;
+  // Pixels are taken by malloc, so the tracker is told about them.
+  int64_t const bytes = loaded.byteCount();
+  MemoryTracker::AddExternal(MemoryTag::Images, bytes);
+
+  return std::shared_ptr<QImage>(new QImage(std::move(loaded)), [bytes](QImage * image)
+  {
+    MemoryTracker::AddExternal(MemoryTag::Images, -bytes);
+    delete image;
+  });
 }
 
 std::shared_ptr<QImage> Images::GetImageBulletAlien()
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+///
+/// Player actions which change the game state.
+///
+enum class InputAction : uint8_t
+{
+  Left,
+  Right,
+  Up,
+  Down,
+  Fire,
+  KillAliens,
+  Menu,
+  Resize
+};
+
+///
+/// A single player command.
+///
+/// Commands are applied between simulation steps, so a command
+/// and the number of the next step fully describe the input.
+///
+struct InputCommand
+{
+  InputAction m_action = InputAction::Fire;
+
+  /// Key state for the movement actions.
+  bool m_isPressed = true;
+
+  /// Play field size for the resize action.
+  int m_width = 0;
+  int m_height = 0;
+};
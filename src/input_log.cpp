@@ -0,0 +1,226 @@
+#include "input_log.hpp"
+
+#include <fstream>
+#include <iterator>
+
+#include "except.hpp"
+
+namespace
+{
+
+char constexpr kMagic[] = { 'S', 'I', 'R', 'P' };
+uint8_t constexpr kVersion = 1;
+uint8_t constexpr kPressedFlag = 0x80;
+
+void WriteVarint(std::string & out, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+void WriteFixed64(std::string & out, uint64_t value)
+{
+  for (int i = 0; i < 8; ++i)
+  {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+class Reader
+{
+public:
+  Reader(std::string const & data, std::string const & fileName)
+    : m_data(data), m_fileName(fileName)
+  {}
+
+  uint8_t ReadByte()
+  {
+    if (m_position >= m_data.size())
+    {
+      throw ReadFileException(m_fileName);
+    }
+    return static_cast<uint8_t>(m_data[m_position++]);
+  }
+
+  uint64_t ReadVarint()
+  {
+    uint64_t value = 0;
+
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+      uint8_t const byte = ReadByte();
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+
+      if (!(byte & 0x80))
+      {
+        return value;
+      }
+    }
+
+    throw ReadFileException(m_fileName);
+  }
+
+  uint64_t ReadFixed64()
+  {
+    uint64_t value = 0;
+
+    for (int i = 0; i < 8; ++i)
+    {
+      value |= static_cast<uint64_t>(ReadByte()) << (8 * i);
+    }
+
+    return value;
+  }
+
+private:
+  std::string const & m_data;
+  std::string const & m_fileName;
+  size_t m_position = 0;
+};
+
+} // namespace
+
+void InputLog::Add(uint64_t tick, InputCommand const & command)
+{
+  InputRecord record;
+  record.m_tick = tick;
+  record.m_command = command;
+
+  m_records.push_back(record);
+}
+
+void InputLog::Write(std::string const & fileName) const
+{
+  std::string out(std::begin(kMagic), std::end(kMagic));
+  out.push_back(static_cast<char>(kVersion));
+
+  WriteVarint(out, m_level);
+  WriteVarint(out, m_seed);
+  WriteVarint(out, m_width);
+  WriteVarint(out, m_height);
+  WriteVarint(out, m_records.size());
+
+  uint64_t tick = 0;
+
+  for (auto const & record : m_records)
+  {
+    InputCommand const & command = record.m_command;
+
+    WriteVarint(out, record.m_tick - tick);
+    tick = record.m_tick;
+
+    uint8_t action = static_cast<uint8_t>(command.m_action);
+    if (command.m_isPressed)
+    {
+      action |= kPressedFlag;
+    }
+    out.push_back(static_cast<char>(action));
+
+    if (command.m_action == InputAction::Resize)
+    {
+      WriteVarint(out, command.m_width);
+      WriteVarint(out, command.m_height);
+    }
+  }
+
+  WriteVarint(out, m_finalTick);
+  WriteVarint(out, m_finalScore);
+  out.push_back(static_cast<char>(m_finalState));
+  WriteFixed64(out, m_finalHash);
+
+  std::ofstream ofs(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+
+  if (!ofs.is_open())
+  {
+    throw WriteFileException(fileName);
+  }
+
+  ofs.write(out.data(), out.size());
+
+  if (!ofs)
+  {
+    throw WriteFileException(fileName);
+  }
+}
+
+InputLog InputLog::Read(std::string const & fileName)
+{
+  std::ifstream ifs(fileName, std::ifstream::binary);
+
+  if (!ifs.is_open())
+  {
+    throw ReadFileException(fileName);
+  }
+
+  std::string const data((std::istreambuf_iterator<char>(ifs)),
+                         std::istreambuf_iterator<char>());
+
+  Reader reader(data, fileName);
+
+  for (char const magic : kMagic)
+  {
+    if (reader.ReadByte() != static_cast<uint8_t>(magic))
+    {
+      throw ReadFileException(fileName);
+    }
+  }
+
+  if (reader.ReadByte() != kVersion)
+  {
+    throw ReadFileException(fileName);
+  }
+
+  InputLog log;
+  log.m_level = reader.ReadVarint();
+  log.m_seed = reader.ReadVarint();
+  log.m_width = static_cast<int>(reader.ReadVarint());
+  log.m_height = static_cast<int>(reader.ReadVarint());
+
+  uint64_t const count = reader.ReadVarint();
+
+  // Every record takes at least two bytes.
+  if (count > data.size() / 2)
+  {
+    throw ReadFileException(fileName);
+  }
+
+  log.m_records.reserve(count);
+
+  uint64_t tick = 0;
+
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    InputRecord record;
+
+    tick += reader.ReadVarint();
+    record.m_tick = tick;
+
+    uint8_t const action = reader.ReadByte();
+    record.m_command.m_action = static_cast<InputAction>(action & ~kPressedFlag);
+    record.m_command.m_isPressed = action & kPressedFlag;
+
+    if (record.m_command.m_action > InputAction::Resize)
+    {
+      throw ReadFileException(fileName);
+    }
+
+    if (record.m_command.m_action == InputAction::Resize)
+    {
+      record.m_command.m_width = static_cast<int>(reader.ReadVarint());
+      record.m_command.m_height = static_cast<int>(reader.ReadVarint());
+    }
+
+    log.m_records.push_back(record);
+  }
+
+  log.m_finalTick = reader.ReadVarint();
+  log.m_finalScore = reader.ReadVarint();
+  log.m_finalState = static_cast<GameState>(reader.ReadByte());
+  log.m_finalHash = reader.ReadFixed64();
+
+  return log;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "input_command.hpp"
+#include "game_state.hpp"
+
+struct InputRecord
+{
+  /// The command is applied before this simulation step.
+  uint64_t m_tick = 0;
+  InputCommand m_command;
+};
+
+///
+/// Recorded game session.
+///
+/// The file stores the session parameters, the commands with delta
+/// encoded step numbers and the final state used to verify a replay.
+///
+struct InputLog
+{
+  void Add(uint64_t tick, InputCommand const & command);
+
+  ///
+  /// Exception: WriteFileException.
+  ///
+  void Write(std::string const & fileName) const;
+
+  ///
+  /// Exception: ReadFileException.
+  ///
+  static InputLog Read(std::string const & fileName);
+
+  /// Session parameters.
+  size_t m_level = 1;
+  uint64_t m_seed = 0;
+  int m_width = 0;
+  int m_height = 0;
+
+  std::vector<InputRecord> m_records;
+
+  /// Final state.
+  uint64_t m_finalTick = 0;
+  size_t m_finalScore = 0;
+  GameState m_finalState = GameState::STOP;
+  // World::GetHistoryHash() at the end of the session.
+  uint64_t m_finalHash = 0;
+};
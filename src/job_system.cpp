@@ -0,0 +1,361 @@
+#include "job_system.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+
+// Index of the queue of the current thread. Outside threads use the first one.
+thread_local size_t t_queueIndex = 0;
+
+// More ranges than threads, so stealing can balance uneven ranges.
+size_t constexpr kRangesPerThread = 4;
+
+} // namespace
+
+struct JobSystem::Job
+{
+  TFunction m_function;
+  std::vector<Job *> m_dependents;
+  size_t m_dependencies = 0;
+  std::atomic<size_t> m_waiting;
+};
+
+struct JobSystem::Range
+{
+  TRangeFunction const * m_function = nullptr;
+  std::atomic<size_t> m_remaining;
+
+  std::mutex m_exceptionMutex;
+  std::exception_ptr m_exception;
+};
+
+JobSystem::JobSystem(size_t threads)
+  : m_remainingJobs(0),
+    m_queuedTasks(0),
+    m_isStopping(false)
+{
+  if (threads == 0)
+  {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  for (size_t i = 0; i < threads; ++i)
+  {
+    m_queues.emplace_back(new Queue());
+  }
+
+  for (size_t i = 1; i < threads; ++i)
+  {
+    m_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+  }
+}
+
+JobSystem::~JobSystem()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_sleepMutex);
+    m_isStopping = true;
+  }
+
+  m_wakeCondition.notify_all();
+
+  for (auto & worker : m_workers)
+  {
+    worker.join();
+  }
+}
+
+size_t JobSystem::GetSize() const
+{
+  return m_queues.size();
+}
+
+JobSystem::TJobId JobSystem::Add(TFunction const & function,
+                                 std::initializer_list<TJobId> dependencies)
+{
+  if (m_jobsNumber == m_jobs.size())
+  {
+    m_jobs.emplace_back(new Job());
+  }
+
+  Job & job = *m_jobs[m_jobsNumber];
+  job.m_function = function;
+  job.m_dependents.clear();
+  job.m_dependencies = dependencies.size();
+
+  for (auto dependency : dependencies)
+  {
+    if (dependency >= m_jobsNumber)
+    {
+      throw std::invalid_argument("A job depends on a job which isn't added yet.");
+    }
+
+    m_jobs[dependency]->m_dependents.push_back(&job);
+  }
+
+  return m_jobsNumber++;
+}
+
+void JobSystem::Run()
+{
+  if (m_jobsNumber == 0)
+  {
+    return;
+  }
+
+  m_exception = nullptr;
+  m_remainingJobs = m_jobsNumber;
+
+  for (size_t i = 0; i < m_jobsNumber; ++i)
+  {
+    m_jobs[i]->m_waiting = m_jobs[i]->m_dependencies;
+  }
+
+  for (size_t i = 0; i < m_jobsNumber; ++i)
+  {
+    if (m_jobs[i]->m_dependencies == 0)
+    {
+      Task task;
+      task.m_job = m_jobs[i].get();
+      Push(task);
+    }
+  }
+
+  while (m_remainingJobs > 0)
+  {
+    Task task;
+
+    if (Pop(task))
+    {
+      Execute(task);
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  // Release the captured state of the jobs.
+  for (size_t i = 0; i < m_jobsNumber; ++i)
+  {
+    m_jobs[i]->m_function = nullptr;
+  }
+
+  m_jobsNumber = 0;
+
+  if (m_exception != nullptr)
+  {
+    std::rethrow_exception(m_exception);
+  }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grain, TRangeFunction const & function)
+{
+  grain = std::max<size_t>(1, grain);
+
+  size_t const ranges = std::min(GetSize() * kRangesPerThread,
+                                 (count + grain - 1) / grain);
+
+  if (ranges <= 1 || m_workers.empty())
+  {
+    if (count > 0)
+    {
+      function(0, count);
+    }
+    return;
+  }
+
+  Range range;
+  range.m_function = &function;
+  range.m_remaining = ranges - 1;
+
+  for (size_t i = 1; i < ranges; ++i)
+  {
+    Task task;
+    task.m_range = &range;
+    task.m_begin = count * i / ranges;
+    task.m_end = count * (i + 1) / ranges;
+    Push(task);
+  }
+
+  // The calling thread takes the first range.
+  std::exception_ptr exception;
+
+  try
+  {
+    function(0, count / ranges);
+  }
+  catch (...)
+  {
+    exception = std::current_exception();
+  }
+
+  // The range lives on this stack, so wait for all its tasks even on error.
+  while (range.m_remaining > 0)
+  {
+    Task task;
+
+    if (Pop(task))
+    {
+      Execute(task);
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  if (exception == nullptr)
+  {
+    exception = range.m_exception;
+  }
+
+  if (exception != nullptr)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+void JobSystem::WorkerLoop(size_t index)
+{
+  t_queueIndex = index;
+
+  while (true)
+  {
+    Task task;
+
+    if (Pop(task))
+    {
+      Execute(task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_sleepMutex);
+    m_wakeCondition.wait(lock, [this]()
+    {
+      return m_isStopping || m_queuedTasks > 0;
+    });
+
+    if (m_isStopping)
+    {
+      return;
+    }
+  }
+}
+
+void JobSystem::Push(Task const & task)
+{
+  Queue & queue = *m_queues[t_queueIndex];
+
+  {
+    std::lock_guard<std::mutex> lock(queue.m_mutex);
+    queue.m_tasks.push_back(task);
+  }
+
+  m_queuedTasks++;
+
+  // Taking the mutex orders the counter with a worker which is going to sleep.
+  {
+    std::lock_guard<std::mutex> lock(m_sleepMutex);
+  }
+
+  m_wakeCondition.notify_one();
+}
+
+bool JobSystem::Pop(Task & task)
+{
+  if (m_queuedTasks == 0)
+  {
+    return false;
+  }
+
+  size_t const index = t_queueIndex;
+
+  // The newest own task, its data is likely in the cache.
+  {
+    Queue & queue = *m_queues[index];
+    std::lock_guard<std::mutex> lock(queue.m_mutex);
+
+    if (queue.m_head < queue.m_tasks.size())
+    {
+      task = queue.m_tasks.back();
+      queue.m_tasks.pop_back();
+      queue.Compact();
+      m_queuedTasks--;
+      return true;
+    }
+  }
+
+  // The oldest task of another thread.
+  for (size_t i = 1; i < m_queues.size(); ++i)
+  {
+    Queue & queue = *m_queues[(index + i) % m_queues.size()];
+    std::lock_guard<std::mutex> lock(queue.m_mutex);
+
+    if (queue.m_head < queue.m_tasks.size())
+    {
+      task = queue.m_tasks[queue.m_head++];
+      queue.Compact();
+      m_queuedTasks--;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void JobSystem::Execute(Task const & task)
+{
+  if (task.m_range != nullptr)
+  {
+    Range & range = *task.m_range;
+
+    try
+    {
+      (*range.m_function)(task.m_begin, task.m_end);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(range.m_exceptionMutex);
+
+      if (range.m_exception == nullptr)
+      {
+        range.m_exception = std::current_exception();
+      }
+    }
+
+    range.m_remaining--;
+    return;
+  }
+
+  Job & job = *task.m_job;
+
+  try
+  {
+    job.m_function();
+  }
+  catch (...)
+  {
+    std::lock_guard<std::mutex> lock(m_exceptionMutex);
+
+    if (m_exception == nullptr)
+    {
+      m_exception = std::current_exception();
+    }
+  }
+
+  for (auto dependent : job.m_dependents)
+  {
+    if (--dependent->m_waiting == 0)
+    {
+      Task next;
+      next.m_job = dependent;
+      Push(next);
+    }
+  }
+
+  // Dependents are queued before, so Run() can't finish too early.
+  m_remainingJobs--;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///
+/// Small work stealing scheduler.
+///
+/// Jobs are added together with the jobs they depend on and run by Run().
+/// Every thread has its own queue. It takes the newest task from it
+/// and steals the oldest task of another thread when the queue is empty.
+///
+/// Run() and ParallelFor() may be called by one outside thread at a time.
+/// ParallelFor() can also be called inside a job.
+///
+class JobSystem
+{
+public:
+  using TJobId = size_t;
+  using TFunction = std::function<void()>;
+  using TRangeFunction = std::function<void(size_t begin, size_t end)>;
+
+  ///
+  /// Zero threads means one thread per hardware core.
+  /// The calling thread is counted, so JobSystem(1) doesn't start any thread.
+  ///
+  explicit JobSystem(size_t threads = 0);
+  ~JobSystem();
+
+  JobSystem(JobSystem const &) = delete;
+  JobSystem & operator=(JobSystem const &) = delete;
+
+  size_t GetSize() const;
+
+  ///
+  /// Add a job which starts when the given jobs are finished.
+  ///
+  /// A job can only depend on jobs which are added before it.
+  ///
+  TJobId Add(TFunction const & function,
+             std::initializer_list<TJobId> dependencies = {});
+
+  ///
+  /// Run the added jobs and wait for them. The calling thread helps.
+  ///
+  /// The first exception of a job is rethrown when all jobs are finished.
+  ///
+  void Run();
+
+  ///
+  /// Split [0, count) into ranges of at least grain items
+  /// and process them on all threads.
+  ///
+  void ParallelFor(size_t count, size_t grain, TRangeFunction const & function);
+
+private:
+  struct Job;
+  struct Range;
+
+  struct Task
+  {
+    Job * m_job = nullptr;
+    Range * m_range = nullptr;
+    size_t m_begin = 0;
+    size_t m_end = 0;
+  };
+
+  ///
+  /// The owner takes the newest task from the back, other threads
+  /// steal the oldest one from the head. The vector keeps its memory,
+  /// so a steady game doesn't allocate tasks.
+  ///
+  struct Queue
+  {
+    std::mutex m_mutex;
+    std::vector<Task> m_tasks;
+    size_t m_head = 0;
+
+    /// Drop the stolen tasks once the queue is empty.
+    void Compact()
+    {
+      if (m_head == m_tasks.size())
+      {
+        m_tasks.clear();
+        m_head = 0;
+      }
+    }
+  };
+
+  void WorkerLoop(size_t index);
+
+  /// Put a task to the queue of the current thread.
+  void Push(Task const & task);
+
+  /// Take a task from the own queue or steal it from another one.
+  bool Pop(Task & task);
+
+  void Execute(Task const & task);
+
+  std::vector<std::unique_ptr<Queue>> m_queues;
+  std::vector<std::thread> m_workers;
+
+  // Jobs are reused by the next Run().
+  std::vector<std::unique_ptr<Job>> m_jobs;
+  size_t m_jobsNumber = 0;
+
+  std::atomic<size_t> m_remainingJobs;
+  std::atomic<size_t> m_queuedTasks;
+
+  std::mutex m_sleepMutex;
+  std::condition_variable m_wakeCondition;
+  std::atomic<bool> m_isStopping;
+
+  std::mutex m_exceptionMutex;
+  std::exception_ptr m_exception;
+};
@@ -0,0 +1,339 @@
+#include "json_stream.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+
+#include "json/reader.h"
+
+#include "except.hpp"
+
+namespace
+{
+
+size_t constexpr kBlockSize = 64 * 1024;
+
+///
+/// Tokenizer of a JSON file. It reads the file block by block
+/// and keeps only one block in memory.
+///
+class Scanner
+{
+public:
+  explicit Scanner(std::string const & fileName)
+    : m_ifs(fileName, std::ifstream::binary)
+    , m_fileName(fileName)
+    , m_buffer(kBlockSize)
+    , m_reader(Json::CharReaderBuilder().newCharReader())
+  {
+    if (!m_ifs.is_open())
+    {
+      throw ReadFileException(fileName);
+    }
+  }
+
+  void SkipSpace()
+  {
+    for (char c = Peek(); c == ' ' || c == '\t' || c == '\n' || c == '\r'; c = Peek())
+    {
+      Get();
+    }
+  }
+
+  bool IsNext(char c)
+  {
+    SkipSpace();
+    return Peek() == c;
+  }
+
+  ///
+  /// Call the function for every member of an object until it returns true.
+  /// The function gets the member name and must consume the value.
+  ///
+  /// Returns true if the function stopped the scan.
+  ///
+  template<typename TFunction>
+  bool ForEachMember(TFunction const & function)
+  {
+    Expect('{');
+
+    if (IsNext('}'))
+    {
+      Get();
+      return false;
+    }
+
+    while (true)
+    {
+      SkipSpace();
+      ReadString(m_key);
+      SkipSpace();
+      Expect(':');
+      SkipSpace();
+
+      if (function(m_key))
+      {
+        return true;
+      }
+
+      SkipSpace();
+      char const c = Get();
+
+      if (c == '}')
+      {
+        return false;
+      }
+      if (c != ',')
+      {
+        Fail();
+      }
+    }
+  }
+
+  /// Skip a value without looking into it.
+  void SkipValue()
+  {
+    char c = Peek();
+
+    if (c == '"')
+    {
+      SkipString();
+    }
+    else if (c == '{' || c == '[')
+    {
+      int depth = 0;
+
+      do
+      {
+        c = Peek();
+
+        if (c == '"')
+        {
+          SkipString();
+          continue;
+        }
+
+        Get();
+
+        if (c == '{' || c == '[')
+        {
+          ++depth;
+        }
+        else if (c == '}' || c == ']')
+        {
+          --depth;
+        }
+      }
+      while (depth > 0);
+    }
+    else
+    {
+      // A number, true, false or null.
+      size_t length = 0;
+
+      for (c = Peek(); c != '\0' && c != ',' && c != '}' && c != ']' &&
+           c != ' ' && c != '\t' && c != '\n' && c != '\r'; c = Peek())
+      {
+        Get();
+        ++length;
+      }
+
+      if (length == 0)
+      {
+        Fail();
+      }
+    }
+  }
+
+  /// Parse the next value with jsoncpp.
+  Json::Value ParseValue()
+  {
+    m_capture.clear();
+    m_isCapturing = true;
+    SkipValue();
+    m_isCapturing = false;
+
+    Json::Value value;
+    std::string errors;
+
+    if (!m_reader->parse(m_capture.data(), m_capture.data() + m_capture.size(),
+                         &value, &errors))
+    {
+      Fail();
+    }
+
+    return value;
+  }
+
+private:
+  /// The next character or '\0' at the end of the file.
+  char Peek()
+  {
+    if (m_position == m_size)
+    {
+      m_ifs.read(m_buffer.data(), m_buffer.size());
+      m_size = static_cast<size_t>(m_ifs.gcount());
+      m_position = 0;
+
+      if (m_size == 0)
+      {
+        return '\0';
+      }
+    }
+
+    return m_buffer[m_position];
+  }
+
+  char Get()
+  {
+    char const c = Peek();
+
+    if (c == '\0')
+    {
+      Fail();
+    }
+
+    ++m_position;
+
+    if (m_isCapturing)
+    {
+      m_capture.push_back(c);
+    }
+
+    return c;
+  }
+
+  void Expect(char c)
+  {
+    if (Get() != c)
+    {
+      Fail();
+    }
+  }
+
+  void ReadString(std::string & out)
+  {
+    out.clear();
+    Expect('"');
+
+    for (char c = Get(); c != '"'; c = Get())
+    {
+      if (c == '\\')
+      {
+        c = Get();
+
+        switch (c)
+        {
+          case 'b': c = '\b'; break;
+          case 'f': c = '\f'; break;
+          case 'n': c = '\n'; break;
+          case 'r': c = '\r'; break;
+          case 't': c = '\t'; break;
+          // Unicode escapes are kept as they are.
+          case 'u': out.push_back('\\'); break;
+          default: break;
+        }
+      }
+
+      out.push_back(c);
+    }
+  }
+
+  void SkipString()
+  {
+    Expect('"');
+
+    for (char c = Get(); c != '"'; c = Get())
+    {
+      if (c == '\\')
+      {
+        Get();
+      }
+    }
+  }
+
+  [[noreturn]] void Fail()
+  {
+    throw ReadFileException(m_fileName);
+  }
+
+  std::ifstream m_ifs;
+  std::string const & m_fileName;
+
+  std::vector<char> m_buffer;
+  size_t m_position = 0;
+  size_t m_size = 0;
+
+  // Text of the value which is parsed.
+  std::string m_capture;
+  bool m_isCapturing = false;
+
+  std::string m_key;
+
+  std::unique_ptr<Json::CharReader> m_reader;
+};
+
+} // namespace
+
+Json::Value JsonStream::Read(std::string const & file_name,
+                             std::vector<std::string> const & path)
+{
+  Scanner scanner(file_name);
+
+  for (auto const & name : path)
+  {
+    if (!scanner.IsNext('{'))
+    {
+      return Json::Value();
+    }
+
+    bool const isFound = scanner.ForEachMember([&scanner, &name](std::string const & key)
+    {
+      if (key == name)
+      {
+        return true;
+      }
+
+      scanner.SkipValue();
+      return false;
+    });
+
+    if (!isFound)
+    {
+      return Json::Value();
+    }
+  }
+
+  scanner.SkipSpace();
+
+  return scanner.ParseValue();
+}
+
+Json::Value JsonStream::ReadMembers(std::string const & file_name,
+                                    std::vector<std::string> const & skip)
+{
+  Scanner scanner(file_name);
+
+  Json::Value members(Json::objectValue);
+
+  if (!scanner.IsNext('{'))
+  {
+    throw ReadFileException(file_name);
+  }
+
+  scanner.ForEachMember([&scanner, &skip, &members](std::string const & key)
+  {
+    if (std::find(skip.begin(), skip.end(), key) != skip.end())
+    {
+      scanner.SkipValue();
+    }
+    else
+    {
+      members[key] = scanner.ParseValue();
+    }
+
+    return false;
+  });
+
+  return members;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "json/value.h"
+
+///
+/// Reads parts of a large JSON file without building the whole tree.
+///
+/// The file is scanned in blocks. Values which aren't requested are
+/// skipped by a tokenizer which only tracks strings and nesting,
+/// the requested value alone is parsed by jsoncpp.
+///
+class JsonStream
+{
+public:
+  JsonStream() = delete;
+  JsonStream(JsonStream const &) = delete;
+  JsonStream(JsonStream const &&) = delete;
+  JsonStream & operator=(JsonStream const &) = delete;
+  JsonStream & operator=(JsonStream const &&) = delete;
+
+  ///
+  /// Parse the value at the path of member names, e.g. { "Level", "2" }.
+  ///
+  /// The scan stops as soon as the value is read. A missing member
+  /// gives a null value.
+  ///
+  /// Exception: ReadFileException.
+  ///
+  static Json::Value Read(std::string const & file_name,
+                          std::vector<std::string> const & path);
+
+  ///
+  /// Parse the members of the root object except the skipped ones.
+  ///
+  /// Exception: ReadFileException.
+  ///
+  static Json::Value ReadMembers(std::string const & file_name,
+                                 std::vector<std::string> const & skip);
+};
@@ -2,6 +2,7 @@
 #include <sstream>
 #include "logger.hpp"
 #include "except.hpp"
+#include "memory_tracker.hpp"
 
 
 // Set default values.
@@ -19,8 +20,12 @@ Logger::Logger(LogLevel level,
                std::string lineNumber,
                std::string const & fileName)
 {
+  MemoryScope scope(MemoryTag::Logger);
+
   static Logger logger;
 
+  std::lock_guard<std::recursive_mutex> lock(GetMutex());
+
   if (level >= m_msgLevel)
   {
     m_isPrint = true;
@@ -35,21 +40,29 @@ Logger::Logger(LogLevel level,
 
 void Logger::SetLogLevel(LogLevel const &type)
 {
+  std::lock_guard<std::recursive_mutex> lock(GetMutex());
+
   m_msgLevel = type;
 }
 
 void Logger::SetPrintFunctionName(bool const &isPrintFunctionName)
 {
+  std::lock_guard<std::recursive_mutex> lock(GetMutex());
+
   m_isPrintFunctionName = isPrintFunctionName;
 }
 
 void Logger::SetPrintLineNumber(bool const & isPrintLineNumber)
 {
+  std::lock_guard<std::recursive_mutex> lock(GetMutex());
+
   m_isPrintLineNumber = isPrintLineNumber;
 }
 
 void Logger::SetPrintFileName(bool const & isPrintFileName)
 {
+  std::lock_guard<std::recursive_mutex> lock(GetMutex());
+
   m_isPrintFileName = isPrintFileName;
 }
 
@@ -82,7 +95,13 @@ std::string Logger::GetLogLevelAsString(LogLevel const &type)
   return label;
 }
 
-void Logger::PrintAdditionalParameters(
+std::recursive_mutex & Logger::GetMutex()
+{
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
+std::string Logger::FormatAdditionalParameters(
     std::string const & functionName,
     std::string lineNumber,
     std::string const & fileName)
@@ -107,54 +126,68 @@ void Logger::PrintAdditionalParameters(
     output << " | ";
   }
 
+  return output.str();
+}
+
+void Logger::Write(std::string const & text)
+{
+  MemoryScope scope(MemoryTag::Logger);
+
   if (m_isPrintToFile)
   {
-    GetFile() << output.str();
+    GetFile() << text;
 
     GetFile().flush();
   }
   else
   {
-    std::cout << output.str();
+    std::cout << text;
   }
 }
 
+void Logger::PrintAdditionalParameters(
+    std::string const & functionName,
+    std::string lineNumber,
+    std::string const & fileName)
+{
+  std::lock_guard<std::recursive_mutex> lock(GetMutex());
+
+  Write(FormatAdditionalParameters(functionName, lineNumber, fileName));
+}
+
 void Logger::Log(LogLevel const & logLevel,
                 std::string const & message,
                 std::string const & functionName,
                 std::string lineNumber,
                 std::string const & fileName)
 {
-  std::stringstream output;
+  MemoryScope scope(MemoryTag::Logger);
+
+  std::lock_guard<std::recursive_mutex> lock(GetMutex());
 
   if (logLevel >= m_msgLevel)
   {
-    PrintAdditionalParameters(
-        functionName, lineNumber, fileName);
-
+    // The whole line is written at once, so lines of different threads don't mix.
+    std::stringstream output;
 
-    if (m_isPrintToFile)
-    {
-      output << message << std::endl;
+    output << FormatAdditionalParameters(functionName, lineNumber, fileName)
+           << message << std::endl;
 
-      GetFile() << output.str();
-
-      GetFile().flush();
-    }
-    else
-    {
-      std::cout << output.str();
-    }
+    Write(output.str());
   }
 }
 
 LogLevel Logger::GetLogLevel()
 {
+  std::lock_guard<std::recursive_mutex> lock(GetMutex());
+
   return m_msgLevel;
 }
 void Logger::SetPrintToFile(std::string const & fileName,
                             const bool & isPrintToFile)
 {
+  std::lock_guard<std::recursive_mutex> lock(GetMutex());
+
   m_fileName = fileName;
   m_isPrintToFile = isPrintToFile;
 
@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <mutex>
 
 #include "singleton.h"
 
@@ -98,6 +99,8 @@ public:
   template<class T>
   Logger & operator << (T const & obj)
   {
+    std::lock_guard<std::recursive_mutex> lock(GetMutex());
+
     if (m_isPrint)
     {
       if (m_isPrintToFile)
@@ -117,6 +120,8 @@ public:
 
   Logger & operator << (std::ostream & (*manip)(std::ostream &))
   {
+    std::lock_guard<std::recursive_mutex> lock(GetMutex());
+
     if (m_isPrint)
     {
       if (m_isPrintToFile)
@@ -138,6 +143,8 @@ public:
   template<typename T, template<typename, typename...> class C, typename... Args>
   Logger & operator << (C<T, Args...> const & objs)
   {
+    std::lock_guard<std::recursive_mutex> lock(GetMutex());
+
     if (m_isPrint)
     {
       for (auto const & obj : objs)
@@ -150,6 +157,24 @@ public:
   }
 
 private:  
+  ///
+  /// It serializes the output of different threads.
+  ///
+  /// Log() writes a whole line at once. The stream operators are
+  /// serialized one by one, so pieces of two LOG() statements
+  /// can still alternate.
+  ///
+  static std::recursive_mutex & GetMutex();
+
+  /// Prefix of a message with the enabled additional parameters.
+  static std::string FormatAdditionalParameters(
+          std::string const & functionName,
+          std::string lineNumber,
+          std::string const & fileName);
+
+  /// Write a text to the current output.
+  static void Write(std::string const & text);
+
   /// Otherwise it won't be accessible in parent class Singleton<Logger>.
   friend class Singleton<Logger>;
 
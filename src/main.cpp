@@ -1,15 +1,52 @@
 #include <QApplication>
+#include <QCoreApplication>
 #include <QMainWindow>
 #include <QSurfaceFormat>
 #include <QDebug>
+#include <QString>
 
 #include "mainwindow.hpp"
 #include "except.hpp"
 #include "images.hpp"
 #include "application.hpp"
+#include "replay.hpp"
+#include "batch_environment.hpp"
+#include "memory_tracker.hpp"
+
+#include <iostream>
+#include <string>
 
 int main(int argc, char ** argv)
 {
+  // Headless replay: SpaceInvaders --replay level_1.replay
+  if (argc == 3 && std::string(argv[1]) == "--replay")
+  {
+    QCoreApplication a(argc, argv);
+
+    return Replay::Run(argv[2], std::cout) ? 0 : 1;
+  }
+
+  // Throughput of the batch environment: SpaceInvaders --batch 64 10000
+  if (argc == 4 && std::string(argv[1]) == "--batch")
+  {
+    QCoreApplication a(argc, argv);
+
+    bool isInstances = false;
+    bool isSteps = false;
+    size_t const instances = QString(argv[2]).toULong(&isInstances);
+    size_t const steps = QString(argv[3]).toULong(&isSteps);
+
+    if (!isInstances || !isSteps || instances == 0)
+    {
+      std::cerr << "Usage: SpaceInvaders --batch <instances> <steps>" << std::endl
+                << "The number of instances must be positive." << std::endl;
+
+      return 1;
+    }
+
+    return BatchEnvironment::RunBenchmark(instances, steps, std::cout) ? 0 : 1;
+  }
+
   Application a(argc, argv);
 
   QSurfaceFormat format;
@@ -20,5 +57,20 @@ int main(int argc, char ** argv)
   MainWindow w;
   w.show();
 
-  return a.exec();
+  int const result = a.exec();
+
+  // Heap usage of the session by subsystems, see the MEMORY_TRACKING option.
+  if (MemoryTracker::IsEnabled())
+  {
+    try
+    {
+      MemoryTracker::WriteJson("memory.json");
+    }
+    catch (WriteFileException const & ex)
+    {
+      qDebug() << ex.what();
+    }
+  }
+
+  return result;
 }
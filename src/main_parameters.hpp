@@ -7,4 +7,29 @@ struct MainParameters
   size_t m_difficulty = 0;
   size_t m_speed = 0;
   size_t m_levelsNumber = 0;
+
+  /// Seed of the random streams. The same seed and input give the same game.
+  uint m_seed = 1;
+
+  /// Advance the simulation with a constant time step.
+  bool m_fixedStep = true;
+
+  /// Store the player commands of every level to a replay file. It is off
+  /// for players, the file of a level is replaced by the next game.
+  bool m_recordReplay = false;
+
+  /// Threads of the game logic, 0 means one per core and 1 runs it serially.
+  uint m_jobThreads = 0;
+
+  /// Run the game logic on its own thread, the GL thread only draws. It needs the fixed step.
+  bool m_renderThread = true;
+
+  /// Aliens which appear in one step at most. It spreads the cost of large waves.
+  uint m_spawnBudget = 64;
+
+  /// Size of the particle buffer. The oldest particles give their places to new ones.
+  uint m_particleCapacity = 4096;
+
+  /// GPU memory of the textures in kilobytes, 0 means no limit.
+  uint m_textureBudget = 65536;
 };
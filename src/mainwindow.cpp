@@ -3,6 +3,8 @@
 #include <QDebug>
 #include <QComboBox>
 
+#include <ctime>
+
 #include "menupage.hpp"
 #include "game_window.hpp"
 #include "settingspage.hpp"
@@ -26,6 +28,15 @@ MainWindow::MainWindow(QWidget *parent) :
 
   setCentralWidget(rootPageWidget);
 
+  try
+  {
+    m_scores.Open(Globals::ScoresFileName);
+  }
+  catch (std::exception const & ex)
+  {
+    qDebug() << ex.what();
+  }
+
   this->setStyleSheet(
     "background-image:url(\"data\/background.jpg\"); background-position: center;" );
 }
@@ -61,7 +72,7 @@ void MainWindow::setCurrentIndex(int value)
       m_finalScore = 0;
       break;
     case 4:
-      pageWidget = new ScoresPage(this);
+      pageWidget = new ScoresPage(this, m_scores);
       break;
     default:
       break;
@@ -132,6 +143,8 @@ void MainWindow::finishGame(GameState gameState, size_t score)
         m_message = "Game over. Congratulations! You win!\nYour score: " \
             + QString::number(m_finalScore);
 
+        AddScore();
+
         m_currentLevel = 1;
 
         m_finalScore = 0;
@@ -147,6 +160,8 @@ void MainWindow::finishGame(GameState gameState, size_t score)
       m_message = "Game over. You lose!\nYour score: " \
             + QString::number(m_finalScore);
 
+      AddScore();
+
       m_currentLevel = 1;
 
       m_finalScore = 0;
@@ -175,3 +190,20 @@ void MainWindow::moveToScoresPage()
 
   setCurrentIndex(4);
 }
+
+void MainWindow::AddScore()
+{
+  ScoreRecord record;
+  record.m_level = static_cast<uint32_t>(m_currentLevel);
+  record.m_score = m_finalScore;
+  record.m_time = static_cast<uint64_t>(std::time(nullptr));
+
+  try
+  {
+    m_scores.Add(record);
+  }
+  catch (WriteFileException const & ex)
+  {
+    qDebug() << ex.what();
+  }
+}
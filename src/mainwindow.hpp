@@ -6,6 +6,7 @@
 #include <QComboBox>
 #include <QString>
 #include "game_state.hpp"
+#include "score_store.hpp"
 
 namespace Ui {
 class MainWindow;
@@ -29,6 +30,12 @@ public slots:
   void finishGame(GameState gameState, size_t);
   void moveToScoresPage();
 
+private:
+  ///
+  /// Store the result of the finished game.
+  ///
+  void AddScore();
+
 public:
   QWidget * rootPageWidget = nullptr;
   QWidget * pageWidget = nullptr;
@@ -40,4 +47,7 @@ public:
   QString m_message;
 
   size_t m_finalScore = 0;
+
+  // Results of all games. It is loaded once at startup.
+  ScoreStore m_scores;
 };
@@ -0,0 +1,250 @@
+#include "memory_tracker.hpp"
+#include "util.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+size_t constexpr kTagCount = static_cast<size_t>(MemoryTag::Count);
+
+// Static atomics are zero before any constructor runs,
+// so allocations of other static objects are counted too.
+std::atomic<uint64_t> g_allocations[kTagCount];
+std::atomic<uint64_t> g_frees[kTagCount];
+std::atomic<int64_t> g_liveBytes[kTagCount];
+std::atomic<int64_t> g_peakBytes[kTagCount];
+
+thread_local MemoryTag g_tag = MemoryTag::Other;
+
+void UpdatePeak(std::atomic<int64_t> & peak, int64_t value)
+{
+  int64_t current = peak.load(std::memory_order_relaxed);
+  while (value > current &&
+         !peak.compare_exchange_weak(current, value, std::memory_order_relaxed))
+  {}
+}
+
+void Add(MemoryTag tag, int64_t bytes)
+{
+  size_t const index = static_cast<size_t>(tag);
+
+  if (bytes >= 0)
+  {
+    g_allocations[index].fetch_add(1, std::memory_order_relaxed);
+  }
+  else
+  {
+    g_frees[index].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  int64_t const live = g_liveBytes[index].fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  UpdatePeak(g_peakBytes[index], live);
+}
+
+char const * const kNames[kTagCount] =
+{
+  "Other", "Settings", "Images", "Space", "Render", "Logger"
+};
+
+} // namespace
+
+#ifdef MEMORY_TRACKING
+
+namespace
+{
+
+// The header keeps the size and the tag of the block
+// and preserves the alignment of malloc.
+struct alignas(std::max_align_t) BlockHeader
+{
+  size_t m_size;
+  MemoryTag m_tag;
+};
+
+void * TrackedAllocate(size_t size) noexcept
+{
+  BlockHeader * header = static_cast<BlockHeader *>(std::malloc(sizeof(BlockHeader) + size));
+  if (header == nullptr)
+  {
+    return nullptr;
+  }
+
+  header->m_size = size;
+  header->m_tag = g_tag;
+  Add(header->m_tag, static_cast<int64_t>(size));
+
+  return header + 1;
+}
+
+void * TrackedNew(size_t size)
+{
+  for (;;)
+  {
+    void * p = TrackedAllocate(size);
+    if (p != nullptr)
+    {
+      return p;
+    }
+
+    std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+void TrackedDelete(void * p) noexcept
+{
+  if (p == nullptr)
+  {
+    return;
+  }
+
+  BlockHeader * header = static_cast<BlockHeader *>(p) - 1;
+  Add(header->m_tag, -static_cast<int64_t>(header->m_size));
+  std::free(header);
+}
+
+} // namespace
+
+void * operator new(size_t size)
+{
+  return TrackedNew(size);
+}
+
+void * operator new[](size_t size)
+{
+  return TrackedNew(size);
+}
+
+void * operator new(size_t size, std::nothrow_t const &) noexcept
+{
+  return TrackedAllocate(size);
+}
+
+void * operator new[](size_t size, std::nothrow_t const &) noexcept
+{
+  return TrackedAllocate(size);
+}
+
+void operator delete(void * p) noexcept
+{
+  TrackedDelete(p);
+}
+
+void operator delete[](void * p) noexcept
+{
+  TrackedDelete(p);
+}
+
+void operator delete(void * p, std::nothrow_t const &) noexcept
+{
+  TrackedDelete(p);
+}
+
+void operator delete[](void * p, std::nothrow_t const &) noexcept
+{
+  TrackedDelete(p);
+}
+
+void operator delete(void * p, size_t) noexcept
+{
+  TrackedDelete(p);
+}
+
+void operator delete[](void * p, size_t) noexcept
+{
+  TrackedDelete(p);
+}
+
+bool MemoryTracker::IsEnabled()
+{
+  return true;
+}
+
+#else
+
+bool MemoryTracker::IsEnabled()
+{
+  return false;
+}
+
+#endif
+
+MemoryStats MemoryTracker::GetStats(MemoryTag tag)
+{
+  size_t const index = static_cast<size_t>(tag);
+
+  MemoryStats stats;
+  stats.m_allocations = g_allocations[index].load(std::memory_order_relaxed);
+  stats.m_frees = g_frees[index].load(std::memory_order_relaxed);
+  stats.m_liveBytes = g_liveBytes[index].load(std::memory_order_relaxed);
+  stats.m_peakBytes = g_peakBytes[index].load(std::memory_order_relaxed);
+  return stats;
+}
+
+MemoryStats MemoryTracker::GetTotal()
+{
+  MemoryStats total;
+
+  // Tags peak at different times, so the sum of the peaks is an upper bound.
+  for (size_t i = 0; i < kTagCount; ++i)
+  {
+    MemoryStats const stats = GetStats(static_cast<MemoryTag>(i));
+    total.m_allocations += stats.m_allocations;
+    total.m_frees += stats.m_frees;
+    total.m_liveBytes += stats.m_liveBytes;
+    total.m_peakBytes += stats.m_peakBytes;
+  }
+
+  return total;
+}
+
+char const * MemoryTracker::GetName(MemoryTag tag)
+{
+  size_t const index = static_cast<size_t>(tag);
+  return index < kTagCount ? kNames[index] : "Unknown";
+}
+
+void MemoryTracker::AddExternal(MemoryTag tag, int64_t bytes)
+{
+  if (IsEnabled())
+  {
+    Add(tag, bytes);
+  }
+}
+
+void MemoryTracker::WriteJson(std::string const & fileName)
+{
+  Json::Value root;
+
+  for (size_t i = 0; i < kTagCount; ++i)
+  {
+    MemoryTag const tag = static_cast<MemoryTag>(i);
+    MemoryStats const stats = GetStats(tag);
+
+    Json::Value & value = root[GetName(tag)];
+    value["Allocations"] = Json::UInt64(stats.m_allocations);
+    value["Frees"] = Json::UInt64(stats.m_frees);
+    value["LiveBytes"] = Json::Int64(stats.m_liveBytes);
+    value["PeakBytes"] = Json::Int64(stats.m_peakBytes);
+  }
+
+  Util::WriteJsonAtomic(fileName, root);
+}
+
+MemoryTag MemoryTracker::GetTag()
+{
+  return g_tag;
+}
+
+void MemoryTracker::SetTag(MemoryTag tag)
+{
+  g_tag = tag;
+}
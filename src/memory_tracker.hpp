@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+///
+/// Subsystems which own the heap memory.
+///
+enum class MemoryTag : uint8_t
+{
+  Other,
+  Settings,
+  Images,
+  Space,
+  Render,
+  Logger,
+  Count
+};
+
+///
+/// Heap usage of one tag.
+///
+struct MemoryStats
+{
+  uint64_t m_allocations = 0;
+  uint64_t m_frees = 0;
+  int64_t m_liveBytes = 0;
+  int64_t m_peakBytes = 0;
+};
+
+///
+/// Accounting of the heap by subsystems.
+///
+/// It is built with the MEMORY_TRACKING option, which replaces the global
+/// operator new and delete. Every block remembers its size and the tag
+/// of the thread which allocated it, so it is returned to the same tag.
+/// Without the option all calls do nothing and the stats are empty.
+///
+/// Qt containers and images take memory by malloc, so they aren't seen
+/// by the hooks. Owners of such memory report it by AddExternal().
+///
+class MemoryTracker
+{
+public:
+  MemoryTracker() = delete;
+  MemoryTracker(MemoryTracker const &) = delete;
+  MemoryTracker(MemoryTracker const &&) = delete;
+  MemoryTracker & operator=(MemoryTracker const &) = delete;
+  MemoryTracker & operator=(MemoryTracker const &&) = delete;
+
+  static bool IsEnabled();
+
+  static MemoryStats GetStats(MemoryTag tag);
+
+  /// All tags together.
+  static MemoryStats GetTotal();
+
+  static char const * GetName(MemoryTag tag);
+
+  ///
+  /// Memory which doesn't come from operator new.
+  /// A negative size releases it.
+  ///
+  static void AddExternal(MemoryTag tag, int64_t bytes);
+
+  ///
+  /// Store the stats of all tags.
+  ///
+  /// Exception: WriteFileException.
+  ///
+  static void WriteJson(std::string const & fileName);
+
+  /// The tag of the current thread.
+  static MemoryTag GetTag();
+  static void SetTag(MemoryTag tag);
+};
+
+///
+/// Allocations of the current thread go to the tag while the scope lives.
+/// Scopes may be nested.
+///
+class MemoryScope
+{
+public:
+  explicit MemoryScope(MemoryTag tag)
+    : m_previous(MemoryTracker::GetTag())
+  {
+    MemoryTracker::SetTag(tag);
+  }
+
+  ~MemoryScope()
+  {
+    MemoryTracker::SetTag(m_previous);
+  }
+
+  MemoryScope(MemoryScope const &) = delete;
+  MemoryScope & operator=(MemoryScope const &) = delete;
+
+private:
+  MemoryTag m_previous;
+};
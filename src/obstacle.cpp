@@ -1,6 +1,7 @@
 #include <stdexcept>
 #include "except.hpp"
 #include "obstacle.hpp"
+#include "snapshot.hpp"
 
 
 Obstacle::~Obstacle()
@@ -30,3 +31,17 @@ std::ostream & operator << (std::ostream & os,
 //     << "; Health: " << obj.GetHealth() << "]";
   return os;
 }
+
+void Obstacle::Save(Snapshot & snapshot) const
+{
+  GameEntity::Save(snapshot);
+
+  snapshot.Write(m_health);
+}
+
+void Obstacle::Restore(Snapshot & snapshot)
+{
+  GameEntity::Restore(snapshot);
+
+  snapshot.Read(m_health);
+}
@@ -18,14 +18,16 @@ public:
 
   Obstacle(int const & health,
            QVector2D const & position,
-           std::shared_ptr<QImage> image,
            TSize const & size)
-    :GameEntity(position, "Obstacle", image, size),
+    :GameEntity(position, "Obstacle", size),
       m_health(health)
   {}
 
   ~Obstacle() override;
 
+  void Save(Snapshot & snapshot) const override;
+  void Restore(Snapshot & snapshot) override;
+
   void Update() override;
   int GetHealth() const;
   void SetHealth(int const & health);
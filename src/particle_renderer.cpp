@@ -0,0 +1,138 @@
+#include "particle_renderer.hpp"
+
+namespace
+{
+
+// Corner of the quad, motion (x, y, vx, vy) and life (birth, lifetime, width, height).
+size_t constexpr kVertexFloats = 10;
+
+// Two triangles in the order of the textured rect.
+float constexpr kCorners[6][2] =
+{
+  { -1.0f, -1.0f }, { -1.0f, 1.0f }, { 1.0f, -1.0f },
+  { -1.0f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, -1.0f }
+};
+
+} // namespace
+
+ParticleRenderer::~ParticleRenderer()
+{
+  delete m_program;
+  delete m_vertexShader;
+  delete m_fragmentShader;
+  m_vbo.destroy();
+}
+
+bool ParticleRenderer::Initialize(QOpenGLFunctions * functions)
+{
+  m_functions = functions;
+  if (m_functions == nullptr) return false;
+
+  m_vertexShader = new QOpenGLShader(QOpenGLShader::Vertex);
+  char const * vsrc =
+    "attribute highp vec2 a_corner;\n"
+    "attribute highp vec4 a_motion;\n"
+    "attribute highp vec4 a_life;\n"
+    "uniform highp float u_time;\n"
+    "uniform highp vec2 u_screen;\n"
+    "varying highp vec2 v_texCoord;\n"
+    "varying mediump float v_alpha;\n"
+    "void main(void)\n"
+    "{\n"
+    "  highp float age = u_time - a_life.x;\n"
+    "  highp float k = clamp(age / a_life.y, 0.0, 1.0);\n"
+    "  highp vec2 position = a_motion.xy + a_motion.zw * age;\n"
+    "  // It grows from a half to one and a half of its size, an expired one collapses.\n"
+    "  highp vec2 size = a_life.zw * (0.5 + k) * step(age, a_life.y);\n"
+    "  gl_Position = vec4(2.0 * position / u_screen - 1.0 + a_corner * size / u_screen, 0.0, 1.0);\n"
+    "  v_texCoord = vec2(0.5 + 0.5 * a_corner.x, 0.5 - 0.5 * a_corner.y);\n"
+    "  v_alpha = 1.0 - k;\n"
+    "}\n";
+  if (!m_vertexShader->compileSourceCode(vsrc)) return false;
+
+  m_fragmentShader = new QOpenGLShader(QOpenGLShader::Fragment);
+  char const * fsrc =
+    "varying highp vec2 v_texCoord;\n"
+    "varying mediump float v_alpha;\n"
+    "uniform sampler2D tex;\n"
+    "void main(void)\n"
+    "{\n"
+    "  highp vec4 color = texture2D(tex, v_texCoord);\n"
+    "  gl_FragColor = vec4(color.rgb, color.a * v_alpha);\n"
+    "}\n";
+  if (!m_fragmentShader->compileSourceCode(fsrc)) return false;
+
+  m_program = new QOpenGLShaderProgram();
+  m_program->addShader(m_vertexShader);
+  m_program->addShader(m_fragmentShader);
+  if (!m_program->link()) return false;
+
+  m_cornerAttr = m_program->attributeLocation("a_corner");
+  m_motionAttr = m_program->attributeLocation("a_motion");
+  m_lifeAttr = m_program->attributeLocation("a_life");
+  m_timeUniform = m_program->uniformLocation("u_time");
+  m_screenUniform = m_program->uniformLocation("u_screen");
+  m_textureUniform = m_program->uniformLocation("tex");
+
+  // The buffer is filled again every frame.
+  m_vbo.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+  m_vbo.create();
+
+  return true;
+}
+
+void ParticleRenderer::Render(
+    std::shared_ptr<QOpenGLTexture> texture,
+    std::vector<Particle> const & particles,
+    float time,
+    QSize const & screenSize)
+{
+  if (texture == nullptr || particles.empty()) return;
+
+  m_vertices.resize(particles.size() * 6 * kVertexFloats);
+  float * vertex = m_vertices.data();
+
+  for (auto const & particle : particles)
+  {
+    for (auto const & corner : kCorners)
+    {
+      vertex[0] = corner[0];
+      vertex[1] = corner[1];
+      vertex[2] = particle.m_x;
+      vertex[3] = particle.m_y;
+      vertex[4] = particle.m_vx;
+      vertex[5] = particle.m_vy;
+      vertex[6] = particle.m_birth;
+      vertex[7] = particle.m_lifetime;
+      vertex[8] = particle.m_width;
+      vertex[9] = particle.m_height;
+      vertex += kVertexFloats;
+    }
+  }
+
+  m_program->bind();
+  m_program->setUniformValue(m_textureUniform, 0); // use texture unit 0
+  m_program->setUniformValue(m_timeUniform, time);
+  m_program->setUniformValue(m_screenUniform,
+                             static_cast<float>(screenSize.width()),
+                             static_cast<float>(screenSize.height()));
+  texture->bind();
+  m_program->enableAttributeArray(m_cornerAttr);
+  m_program->enableAttributeArray(m_motionAttr);
+  m_program->enableAttributeArray(m_lifeAttr);
+
+  int const stride = kVertexFloats * sizeof(float);
+
+  m_vbo.bind();
+  m_vbo.allocate(m_vertices.data(), static_cast<int>(m_vertices.size() * sizeof(float)));
+  m_program->setAttributeBuffer(m_cornerAttr, GL_FLOAT, 0, 2, stride);
+  m_program->setAttributeBuffer(m_motionAttr, GL_FLOAT, 2 * sizeof(float), 4, stride);
+  m_program->setAttributeBuffer(m_lifeAttr, GL_FLOAT, 6 * sizeof(float), 4, stride);
+  m_vbo.release();
+  m_functions->glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(particles.size() * 6));
+
+  m_program->disableAttributeArray(m_cornerAttr);
+  m_program->disableAttributeArray(m_motionAttr);
+  m_program->disableAttributeArray(m_lifeAttr);
+  m_program->release();
+}
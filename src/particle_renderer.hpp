@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QOpenGLFunctions>
+#include <QOpenGLBuffer>
+#include <QOpenGLTexture>
+#include <QOpenGLShader>
+#include <QOpenGLShaderProgram>
+#include <QSize>
+
+#include <memory>
+#include <vector>
+
+#include "particle_system.hpp"
+
+///
+/// Draws all particles with one texture in one call.
+///
+/// Every particle is a quad of the birth state. The vertex shader
+/// moves it by the age, grows it and fades it out, so the particles
+/// are written to the buffer as they are and nothing is computed
+/// per particle on the CPU.
+///
+class ParticleRenderer
+{
+public:
+  ParticleRenderer() = default;
+  ~ParticleRenderer();
+
+  bool Initialize(QOpenGLFunctions * functions);
+
+  void Render(std::shared_ptr<QOpenGLTexture> texture,
+              std::vector<Particle> const & particles,
+              float time,
+              QSize const & screenSize);
+
+private:
+  QOpenGLFunctions * m_functions = nullptr;
+
+  QOpenGLShader * m_vertexShader = nullptr;
+  QOpenGLShader * m_fragmentShader = nullptr;
+  QOpenGLShaderProgram * m_program = nullptr;
+
+  QOpenGLBuffer m_vbo;
+
+  // Vertices of the last frame. It is kept to reuse the memory.
+  std::vector<float> m_vertices;
+
+  int m_cornerAttr = 0;
+  int m_motionAttr = 0;
+  int m_lifeAttr = 0;
+  int m_timeUniform = 0;
+  int m_screenUniform = 0;
+  int m_textureUniform = 0;
+};
@@ -0,0 +1,137 @@
+#include "particle_system.hpp"
+
+#include <algorithm>
+
+#include "snapshot.hpp"
+
+ParticleSystem::ParticleSystem(size_t capacity)
+  : m_particles(capacity)
+{}
+
+void ParticleSystem::Emit(QVector2D const & position,
+                          QVector2D const & velocity,
+                          float lifetime,
+                          TSize const & size)
+{
+  if (m_particles.empty())
+  {
+    return;
+  }
+
+  size_t const capacity = m_particles.size();
+
+  // The oldest particle gives its place.
+  if (m_count == capacity)
+  {
+    m_first = (m_first + 1) % capacity;
+    --m_count;
+  }
+
+  Particle & particle = m_particles[(m_first + m_count) % capacity];
+  particle.m_x = position.x();
+  particle.m_y = position.y();
+  particle.m_vx = velocity.x();
+  particle.m_vy = velocity.y();
+  particle.m_birth = m_time;
+  particle.m_lifetime = lifetime;
+  particle.m_width = size.first;
+  particle.m_height = size.second;
+
+  ++m_count;
+}
+
+void ParticleSystem::Update(float elapsedSeconds)
+{
+  m_time += elapsedSeconds;
+
+  while (m_count > 0)
+  {
+    Particle const & particle = m_particles[m_first];
+
+    if (m_time - particle.m_birth < particle.m_lifetime)
+    {
+      break;
+    }
+
+    m_first = (m_first + 1) % m_particles.size();
+    --m_count;
+  }
+}
+
+void ParticleSystem::Scale(float x, float y)
+{
+  for (auto & particle : m_particles)
+  {
+    particle.m_x *= x;
+    particle.m_y *= y;
+    particle.m_vx *= x;
+    particle.m_vy *= y;
+  }
+}
+
+void ParticleSystem::Clear()
+{
+  m_first = 0;
+  m_count = 0;
+  m_time = 0.0f;
+}
+
+void ParticleSystem::CopyTo(std::vector<Particle> & particles) const
+{
+  particles.clear();
+
+  // At most two pieces of the ring.
+  size_t const tail = std::min(m_count, m_particles.size() - m_first);
+
+  particles.insert(particles.end(),
+                   m_particles.begin() + m_first,
+                   m_particles.begin() + m_first + tail);
+  particles.insert(particles.end(),
+                   m_particles.begin(),
+                   m_particles.begin() + (m_count - tail));
+}
+
+size_t ParticleSystem::GetCount() const
+{
+  return m_count;
+}
+
+size_t ParticleSystem::GetCapacity() const
+{
+  return m_particles.size();
+}
+
+float ParticleSystem::GetTime() const
+{
+  return m_time;
+}
+
+void ParticleSystem::Save(Snapshot & snapshot) const
+{
+  snapshot.Write(m_time);
+  snapshot.Write(static_cast<uint32_t>(m_count));
+
+  for (size_t i = 0; i < m_count; ++i)
+  {
+    snapshot.Write(m_particles[(m_first + i) % m_particles.size()]);
+  }
+}
+
+void ParticleSystem::Restore(Snapshot & snapshot)
+{
+  snapshot.Read(m_time);
+  uint32_t const count = snapshot.Read<uint32_t>();
+
+  if (count > m_particles.size())
+  {
+    throw ReadSnapshotException();
+  }
+
+  m_first = 0;
+  m_count = count;
+
+  for (size_t i = 0; i < m_count; ++i)
+  {
+    snapshot.Read(m_particles[i]);
+  }
+}
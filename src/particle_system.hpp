@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QVector2D>
+
+#include <cstdint>
+#include <vector>
+
+#include "game_entity.hpp"
+
+class Snapshot;
+
+///
+/// One particle. Its motion is a function of the age, so it is written
+/// once at the birth and the vertex shader animates it.
+///
+struct Particle
+{
+  /// Position at the birth.
+  float m_x = 0.0f;
+  float m_y = 0.0f;
+  /// Velocity in pixels per second.
+  float m_vx = 0.0f;
+  float m_vy = 0.0f;
+  /// Birth time on the clock of the particle system in seconds.
+  float m_birth = 0.0f;
+  /// Seconds.
+  float m_lifetime = 0.0f;
+  /// Size at the birth, the particle grows while it fades out.
+  float m_width = 0.0f;
+  float m_height = 0.0f;
+};
+
+///
+/// Fixed size ring buffer of particles.
+///
+/// Particles are kept in the birth order. The oldest particle is
+/// replaced when the buffer is full, and particles are retired from
+/// the old end once they expire. A short lived particle which comes
+/// after a long lived one stays in the buffer a bit longer, it isn't
+/// drawn after the end of its lifetime.
+///
+class ParticleSystem
+{
+public:
+  explicit ParticleSystem(size_t capacity = 0);
+
+  ///
+  /// Emit a particle which is born now.
+  ///
+  void Emit(QVector2D const & position,
+            QVector2D const & velocity,
+            float lifetime,
+            TSize const & size);
+
+  ///
+  /// Advance the clock and retire expired particles.
+  ///
+  void Update(float elapsedSeconds);
+
+  ///
+  /// Scale the positions and velocities, it is used on resize.
+  ///
+  void Scale(float x, float y);
+
+  ///
+  /// Remove all particles and restart the clock. The buffer is kept.
+  ///
+  void Clear();
+
+  ///
+  /// Replace the content by the particles in the birth order.
+  /// The memory of the vector is reused.
+  ///
+  void CopyTo(std::vector<Particle> & particles) const;
+
+  /// Particles in the buffer.
+  size_t GetCount() const;
+  size_t GetCapacity() const;
+
+  /// The clock in seconds.
+  float GetTime() const;
+
+  void Save(Snapshot & snapshot) const;
+
+  ///
+  /// Exception: ReadSnapshotException.
+  ///
+  void Restore(Snapshot & snapshot);
+
+private:
+  std::vector<Particle> m_particles;
+  // The oldest particle.
+  size_t m_first = 0;
+  size_t m_count = 0;
+  float m_time = 0.0f;
+};
@@ -0,0 +1,34 @@
+#include "random.hpp"
+
+uint64_t constexpr Pcg32::kMultiplier;
+
+Pcg32::Pcg32(uint64_t seed, uint64_t stream)
+{
+  Seed(seed, stream);
+}
+
+void Pcg32::Seed(uint64_t seed, uint64_t stream)
+{
+  m_state = 0u;
+  m_increment = (stream << 1u) | 1u;
+  Next();
+  m_state += seed;
+  Next();
+}
+
+void Pcg32::SetState(uint64_t state, uint64_t increment)
+{
+  m_state = state;
+  m_increment = increment | 1u;
+}
+
+bool Pcg32::operator == (Pcg32 const & rhs) const
+{
+  return m_state == rhs.m_state
+      && m_increment == rhs.m_increment;
+}
+
+bool Pcg32::operator != (Pcg32 const & rhs) const
+{
+  return !operator==(rhs);
+}
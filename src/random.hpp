@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+
+///
+/// PCG32 random number generator.
+///
+/// Look here for more info: http://www.pcg-random.org/
+///
+/// Generators with the same seed and different streams produce
+/// independent sequences, so every subsystem can own its stream
+/// and the order of calls in one subsystem doesn't affect the others.
+///
+class Pcg32
+{
+public:
+  Pcg32() = default;
+
+  Pcg32(uint64_t seed, uint64_t stream);
+
+  void Seed(uint64_t seed, uint64_t stream);
+
+  uint32_t Next()
+  {
+    uint64_t const old = m_state;
+    m_state = old * kMultiplier + m_increment;
+
+    uint32_t const xorShifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+    uint32_t const rotation = static_cast<uint32_t>(old >> 59u);
+
+    return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31u));
+  }
+
+  ///
+  /// Generate a random number in [0, 1).
+  ///
+  float NextFloat()
+  {
+    // Use 24 bits to fill the float mantissa.
+    return (Next() >> 8) * (1.0f / 16777216.0f);
+  }
+
+  ///
+  /// Generate a random number in [min, max).
+  ///
+  float NextFloat(float min, float max)
+  {
+    return min + (max - min) * NextFloat();
+  }
+
+  ///
+  /// Raw generator state. It is used to save and restore the game.
+  ///
+  uint64_t GetState() const { return m_state; }
+  uint64_t GetIncrement() const { return m_increment; }
+  void SetState(uint64_t state, uint64_t increment);
+
+  bool operator == (Pcg32 const & rhs) const;
+  bool operator != (Pcg32 const & rhs) const;
+
+private:
+  static uint64_t constexpr kMultiplier = 6364136223846793005ULL;
+
+  uint64_t m_state = 0x853c49e6748fea9bULL;
+  uint64_t m_increment = 0xda3e39cb94b95bdbULL;
+};
+
+///
+/// Streams of the game subsystems.
+///
+enum class RandomStream : uint64_t
+{
+  Stars = 1,
+  Aliens = 2,
+  Particles = 3
+};
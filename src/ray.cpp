@@ -1,8 +1,9 @@
 #include "ray.hpp"
 
-#include <math.h>
+#include <cmath>
 #include <array>
 #include <algorithm>
+#include <limits>
 
 #include "constants.hpp"
 #include "box2d.hpp"
@@ -49,10 +50,14 @@ bool Ray::operator !=(Ray const & rhs) const
 
 Point2D Ray::normalize(Point2D direction)
 {
-  float x = checkZeroDenominator(direction.x());
-  float y = checkZeroDenominator(direction.y());
+  float const length = std::sqrt(direction.x() * direction.x() +
+                                 direction.y() * direction.y());
 
-  float length = sqrt(pow(x, 2.0) + pow(y, 2.0));
+  // There is no direction for a zero vector.
+  if (length < Constants::kEps)
+  {
+    return Point2D(0.0f, 0.0f);
+  }
 
   direction /= length;
 
@@ -66,184 +71,117 @@ Ray & Ray::operator=(const Ray & rhs)
   return *this;
 }
 
-bool Ray::checkIntersection(
-    Ray const & ray,
-    Box2D const & box)
+namespace
+{
+
+///
+/// Clip the [entry, exit] range of a ray by the slab of one axis.
+///
+/// A parallel ray never crosses the slab, so it is inside
+/// or outside of it for the whole length.
+///
+bool ClipSlab(float origin, float boxMin, float boxMax,
+              bool isParallel, float inverse,
+              float & entry, float & exit)
 {
-  // Check if a point inside a box.
-  if (Box2D::checkInside(box, ray.origin()))
+  if (isParallel)
   {
-    return true;
+    return origin >= boxMin && origin <= boxMax;
   }
 
-  bool isSpecial = false;
+  float near = (boxMin - origin) * inverse;
+  float far = (boxMax - origin) * inverse;
 
-  // Recalculate box points.
-  // Use the point as an origin of a coordinate system for the box.
-  float xBoxMinLower = box.boxMin().x() - ray.origin().x();
-  float xBoxMaxUpper = box.boxMax().x() - ray.origin().x();
-
-  float yBoxMinLower = box.boxMin().y() - ray.origin().y();
-  float yBoxMaxUpper = box.boxMax().y() - ray.origin().y();
-
-  float xBoxMinUpper = xBoxMinLower;
-  float yBoxMinUpper = yBoxMaxUpper;
-
-  float xBoxMaxLower = xBoxMaxUpper;
-  float yBoxMaxLower = yBoxMinLower;
-
-  float xRay = ray.direction().x();
-  float yRay = ray.direction().y();
-
-  // It handels special case when rectangle intersepts x-axis
-  // to the right from an origin point of a ray.
-  if (xRay < xBoxMinLower)
+  if (near > far)
   {
-    isSpecial = true;
+    std::swap(near, far);
   }
 
-  // Check if the x coordinate is zero.
-  xRay = checkZeroDenominator(xRay);
-  xBoxMinLower = checkZeroDenominator(xBoxMinLower);
-  xBoxMaxUpper = checkZeroDenominator(xBoxMaxUpper);
-  xBoxMinUpper = checkZeroDenominator(xBoxMinUpper);
-  xBoxMaxLower = checkZeroDenominator(xBoxMaxLower);
-
-  // Calculate an anlge for the current point
-  // and convert the angle to degrees.
-  float angleRay = convertRadianToDegrees(
-        std::atan(yRay / xRay));
+  entry = std::max(entry, near);
+  exit = std::min(exit, far);
 
-  float angleBoxMinLower = convertRadianToDegrees(
-        std::atan(yBoxMinLower / xBoxMinLower));
-
-  float angleBoxMaxUpper = convertRadianToDegrees(
-        std::atan(yBoxMaxUpper / xBoxMaxUpper));
-
-  float angleBoxMinUpper = convertRadianToDegrees(
-        std::atan(yBoxMinUpper / xBoxMinUpper));
-
-  float angleBoxMaxLower = convertRadianToDegrees(
-        std::atan(yBoxMaxLower / xBoxMaxLower));
-
-  // Correct a value of the angle if needed.
-  angleRay = recalculateAngle(
-        xRay, yRay, angleRay);
-
-  angleBoxMinLower = recalculateAngle(
-        xBoxMinLower, yBoxMinLower, angleBoxMinLower);
-
-  angleBoxMaxUpper = recalculateAngle(
-        xBoxMaxUpper, yBoxMaxUpper, angleBoxMaxUpper);
-
-  angleBoxMinUpper = recalculateAngle(
-        xBoxMinUpper, yBoxMinUpper, angleBoxMinUpper);
+  return entry <= exit;
+}
 
-  angleBoxMaxLower = recalculateAngle(
-        xBoxMaxLower, yBoxMaxLower, angleBoxMaxLower);
+///
+/// Parameters of a ray which are shared by the tests with many boxes.
+///
+struct Slabs
+{
+  explicit Slabs(Ray const & ray)
+    : m_origin(ray.origin()),
+      m_isParallelX(ray.direction().x() == 0.0f),
+      m_isParallelY(ray.direction().y() == 0.0f),
+      m_inverseX(m_isParallelX ? 0.0f : 1.0f / ray.direction().x()),
+      m_inverseY(m_isParallelY ? 0.0f : 1.0f / ray.direction().y())
+  {}
+
+  bool Intersect(Box2D const & box, float & entry, float & exit) const
+  {
+    entry = 0.0f;
+    exit = std::numeric_limits<float>::infinity();
 
-  // Combine all angles for the box points.
-  std::array<float, 4> angles = {
-    angleBoxMinLower, angleBoxMaxUpper,
-    angleBoxMinUpper, angleBoxMaxLower
-  };
+    return ClipSlab(m_origin.x(), box.boxMin().x(), box.boxMax().x(),
+                    m_isParallelX, m_inverseX, entry, exit) &&
+           ClipSlab(m_origin.y(), box.boxMin().y(), box.boxMax().y(),
+                    m_isParallelY, m_inverseY, entry, exit);
+  }
 
-  if (isSpecial)
-  {
-    // It finds to angles.
-    // Maximum angle in the first quater
-    // and the minimun angle in the fouth quater.
-    float angleMaxFirstQuater = 0.0f;
-    float angleMinFourthQuater = 360.0f;
+  Point2D m_origin;
+  bool m_isParallelX;
+  bool m_isParallelY;
+  float m_inverseX;
+  float m_inverseY;
+};
 
-    for (auto const & item : angles)
-    {
-      if (item < 90.0f)
-      {
-        if (angleMaxFirstQuater < item)
-        {
-          angleMaxFirstQuater = item;
-        }
-      }
-      else if (item > 270.0f)
-      {
-        if (angleMinFourthQuater > item)
-        {
-          angleMinFourthQuater = item;
-        }
-      }
-    }
+} // namespace
 
-    // Compare the ray angle with
-    // the max angle in the first quater
-    // and the min angle in the fouth quater.
-    if (angleRay <= angleMaxFirstQuater &&
-        angleRay >= angleMinFourthQuater) {
-      return true;
-    }
-  }
-  else
-  {
-    // Find a min and max angles for the box points.
-    auto result = std::minmax_element(
-          std::begin(angles), std::end(angles));
-
-    // Compare the ray angle with the min
-    // and max angles for the box points.
-    if (*result.first <= angleRay &&
-        angleRay <= *result.second) {
-      return true;
-    }
-  }
+bool Ray::checkIntersection(
+    Ray const & ray,
+    Box2D const & box)
+{
+  float entry = 0.0f;
+  float exit = 0.0f;
 
-  return false;
+  return intersect(ray, box, entry, exit);
 }
 
-float Ray::convertRadianToDegrees(float const & angle)
+bool Ray::intersect(Ray const & ray,
+                    Box2D const & box,
+                    float & entry,
+                    float & exit)
 {
-  return angle / Constants::PI * 180;
+  return Slabs(ray).Intersect(box, entry, exit);
 }
 
-float Ray::recalculateAngle(float const & x,
-                            float const & y,
-                            float const & angle)
+size_t Ray::intersect(Ray const & ray,
+                      Box2D const * boxes,
+                      size_t count,
+                      float * entries)
 {
-  float correctedAngle = 0.0f;
+  Slabs const slabs(ray);
 
-  // The second quarter.
-  if (y > (0.0f - Constants::kEps) &&
-      x < (0.0f + Constants::kEps))
-  {
-    correctedAngle = 180.0f - abs(angle);
-  }
+  size_t nearest = count;
+  float nearestEntry = std::numeric_limits<float>::infinity();
 
-  // The third quarter.
-  if (y < 0.0f &&
-      x < (0.0f + Constants::kEps))
+  for (size_t i = 0; i < count; ++i)
   {
-    correctedAngle = 180.0f + abs(angle);
-  }
-
-  // The fouth quarter.
-  if (y < 0.0f &&
-      x > 0.0f)
-  {
-    correctedAngle = 360.0f - abs(angle);
-  }
-
-  return correctedAngle;
-}
+    float exit = 0.0f;
 
-float Ray::checkZeroDenominator(float const & value)
-{
-  float tmp = value;
+    if (!slabs.Intersect(boxes[i], entries[i], exit))
+    {
+      entries[i] = std::numeric_limits<float>::infinity();
+      continue;
+    }
 
-  if (abs(tmp) < Constants::kEps)
-  {
-    tmp = Constants::kEps;
+    if (entries[i] < nearestEntry)
+    {
+      nearestEntry = entries[i];
+      nearest = i;
+    }
   }
 
-  return tmp;
+  return nearest;
 }
 
 void Ray::setOrigin(const Point2D & origin)
@@ -41,25 +41,29 @@ public:
                                 Box2D const & box);
 
   ///
-  /// Convert radian to degrees.
+  /// Slab test of a ray and a box.
   ///
-  static float convertRadianToDegrees(
-      float const & angle);
-
-  ///
-  /// Convert an angle from 0-90 to 0-360 degrees.
+  /// entry and exit are distances along the ray where it enters
+  /// and leaves the box, entry is zero if the origin is inside.
+  /// Axis-parallel rays are handled exactly, touching an edge is a hit.
   ///
-  static float recalculateAngle(
-      float const & x,
-      float const & y,
-      float const & angle);
+  static bool intersect(Ray const & ray,
+                        Box2D const & box,
+                        float & entry,
+                        float & exit);
 
   ///
-  /// Check zero denominator.
+  /// Slab test of a ray and many boxes.
+  ///
+  /// entries receives the entry distance for every box,
+  /// infinity if the box is missed.
   ///
-  /// If it equalts to zero then simply return a small number.
+  /// Returns the index of the nearest box or count if all are missed.
   ///
-  static float checkZeroDenominator(float const & value);
+  static size_t intersect(Ray const & ray,
+                          Box2D const * boxes,
+                          size_t count,
+                          float * entries);
 
   void setOrigin(Point2D const & point);
   void setDirection(Point2D const & point);
@@ -0,0 +1,84 @@
+#include "render_list.hpp"
+
+#include <cmath>
+
+#include "world.hpp"
+#include "constants.hpp"
+#include "memory_tracker.hpp"
+
+namespace
+{
+
+template<typename T>
+void AddItems(std::vector<DrawItem> & items,
+              std::list<std::shared_ptr<T>> const & list,
+              RenderAsset asset)
+{
+  for (auto const & entity : list)
+  {
+    DrawItem item;
+    item.m_asset = asset;
+    item.m_position = entity->GetPosition();
+    item.m_size = entity->GetSize();
+    items.push_back(item);
+  }
+}
+
+} // namespace
+
+void RenderList::Build(World const & world)
+{
+  MemoryScope scope(MemoryTag::Render);
+
+  Space & space = *world.GetSpace();
+
+  m_items.clear();
+
+  m_fieldSize = world.GetFieldSize();
+  m_tick = world.GetTick();
+  m_score = world.GetScore();
+  m_health = space.GetSpaceShip()->GetHealth();
+  m_gameState = world.GetGameState();
+
+  FrameArena const & arena = world.GetFrameArena();
+  m_arenaBytes = arena.GetUsed();
+  m_arenaAllocations = arena.GetAllocations();
+  m_arenaHeapAllocations = arena.GetHeapAllocations();
+
+  AddItems(m_items, space.GetAliens(), RenderAsset::Alien);
+
+  DrawItem spaceShip;
+  spaceShip.m_asset = RenderAsset::SpaceShip;
+  spaceShip.m_position = space.GetSpaceShip()->GetPosition();
+  spaceShip.m_size = space.GetSpaceShip()->GetSize();
+  m_items.push_back(spaceShip);
+
+  AddItems(m_items, space.GetSpaceShipBullets(), RenderAsset::Bullet);
+  AddItems(m_items, space.GetAlienBullets(), RenderAsset::AlienBullet);
+  AddItems(m_items, space.GetObstacles(), RenderAsset::Obstacle);
+
+  // Stars twinkle in random places.
+  std::vector<RandomStar> const & randomStars = world.GetRandomStars();
+  size_t i = 0;
+
+  for (auto const & star : space.GetStars())
+  {
+    if (i >= randomStars.size())
+    {
+      break;
+    }
+
+    RandomStar const & randomStar = randomStars[i++];
+
+    DrawItem item;
+    item.m_asset = RenderAsset::Star;
+    item.m_position = QVector2D(randomStar.m_randomStar.first * m_fieldSize.width(),
+                                randomStar.m_randomStar.second * m_fieldSize.height());
+    item.m_size = star->GetSize();
+    item.m_blend = static_cast<float>(sin(randomStar.m_periodStar * 2 * Constants::PI));
+    m_items.push_back(item);
+  }
+
+  world.GetParticles().CopyTo(m_particles);
+  m_particleTime = world.GetParticles().GetTime();
+}
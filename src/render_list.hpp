@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QSize>
+#include <QVector2D>
+
+#include <cstdint>
+#include <vector>
+
+#include "game_entity.hpp"
+#include "game_state.hpp"
+#include "particle_system.hpp"
+
+class World;
+
+///
+/// Images which are drawn. Every image has one texture on the GL side.
+///
+enum class RenderAsset : uint8_t
+{
+  Alien,
+  SpaceShip,
+  Bullet,
+  AlienBullet,
+  Obstacle,
+  Explosion,
+  Star,
+  Count
+};
+
+struct DrawItem
+{
+  RenderAsset m_asset = RenderAsset::Alien;
+  QVector2D m_position;
+  TSize m_size;
+  float m_blend = 1.0f;
+};
+
+///
+/// Everything which is needed to draw one state of the game.
+///
+/// It is a plain copy, so it can be drawn while the game goes on.
+///
+struct RenderList
+{
+  ///
+  /// Replace the content by the current state of the world.
+  /// The memory of the items is reused.
+  ///
+  void Build(World const & world);
+
+  std::vector<DrawItem> m_items;
+
+  /// Particles are animated by the clock when they are drawn.
+  std::vector<Particle> m_particles;
+  float m_particleTime = 0.0f;
+
+  QSize m_fieldSize;
+  uint64_t m_tick = 0;
+  size_t m_score = 0;
+  int m_health = 0;
+  GameState m_gameState = GameState::RUNINIG;
+
+  /// Frame arena of the step: bytes, allocations and heap blocks taken so far.
+  size_t m_arenaBytes = 0;
+  size_t m_arenaAllocations = 0;
+  uint64_t m_arenaHeapAllocations = 0;
+};
@@ -0,0 +1,82 @@
+#include "replay.hpp"
+
+#include <chrono>
+
+#include "input_log.hpp"
+#include "world.hpp"
+#include "settings.hpp"
+#include "images.hpp"
+#include "except.hpp"
+
+bool Replay::Run(std::string const & fileName, std::ostream & os)
+{
+  InputLog log;
+
+  try
+  {
+    log = InputLog::Read(fileName);
+
+    Images::Instance().LoadImages();
+
+    Settings::Instance().LoadMainSettings();
+    Settings::Instance().LoadLevelSettings(std::to_string(log.m_level));
+  }
+  catch (std::exception const & ex)
+  {
+    os << ex.what() << std::endl;
+
+    return false;
+  }
+
+  // Restore the session parameters.
+  GameContext context = GameContext::FromSettings();
+  context.m_parameters.m_mainParameters.m_seed = log.m_seed;
+  context.m_fieldSize = QSize(log.m_width, log.m_height);
+
+  World world(context, log.m_level);
+  world.Initialize();
+
+  auto record = log.m_records.cbegin();
+
+  auto const start = std::chrono::steady_clock::now();
+
+  while (true)
+  {
+    while (record != log.m_records.cend() &&
+           record->m_tick == world.GetTick())
+    {
+      world.Apply(record->m_command);
+      ++record;
+    }
+
+    if (world.GetTick() >= log.m_finalTick ||
+        world.GetGameState() != GameState::RUNINIG)
+    {
+      break;
+    }
+
+    world.Tick(World::kFixedTimeStep);
+  }
+
+  auto const finish = std::chrono::steady_clock::now();
+
+  double const seconds = std::chrono::duration<double>(finish - start).count();
+
+  uint64_t const hash = world.GetHistoryHash();
+
+  bool const isMatched = world.GetTick() == log.m_finalTick &&
+      world.GetScore() == log.m_finalScore &&
+      world.GetGameState() == log.m_finalState &&
+      hash == log.m_finalHash;
+
+  os << "Replay: " << fileName << std::endl
+     << "Ticks: " << world.GetTick() << " (recorded " << log.m_finalTick << ")" << std::endl
+     << "Score: " << world.GetScore() << " (recorded " << log.m_finalScore << ")" << std::endl
+     << "Hash: " << std::hex << hash << " (recorded " << log.m_finalHash << ")"
+     << std::dec << std::endl
+     << "Time: " << seconds << " s, "
+     << (seconds > 0.0 ? world.GetTick() / seconds : 0.0) << " ticks/s" << std::endl
+     << (isMatched ? "OK" : "MISMATCH") << std::endl;
+
+  return isMatched;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+
+///
+/// It runs a recorded session without rendering.
+///
+class Replay
+{
+public:
+  Replay() = delete;
+  Replay(Replay const &) = delete;
+  Replay(Replay const &&) = delete;
+  Replay & operator=(Replay const &) = delete;
+  Replay & operator=(Replay const &&) = delete;
+
+  ///
+  /// Feed the recorded commands to the game as fast as possible
+  /// and compare the final score and state hash with the recorded ones.
+  ///
+  /// Return true if the replay matches the record.
+  ///
+  static bool Run(std::string const & fileName, std::ostream & os);
+};
@@ -0,0 +1,304 @@
+#include "score_store.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "except.hpp"
+
+namespace
+{
+
+char constexpr kHeader[] = { 'S', 'I', 'S', 'C', 1, 0, 0, 0 };
+size_t constexpr kHeaderSize = sizeof(kHeader);
+
+// Level, score, time and the checksum of them.
+size_t constexpr kPayloadSize = 4 + 8 + 8;
+size_t constexpr kRecordSize = kPayloadSize + 4;
+
+// Records of one read of the log.
+size_t constexpr kReadRecords = 4096;
+
+uint32_t Crc32(char const * data, size_t size)
+{
+  static std::array<uint32_t, 256> const table = []
+  {
+    std::array<uint32_t, 256> values;
+
+    for (uint32_t i = 0; i < values.size(); ++i)
+    {
+      uint32_t value = i;
+      for (int bit = 0; bit < 8; ++bit)
+      {
+        value = (value & 1) ? 0xedb88320u ^ (value >> 1) : value >> 1;
+      }
+      values[i] = value;
+    }
+
+    return values;
+  }();
+
+  uint32_t crc = 0xffffffffu;
+
+  for (size_t i = 0; i < size; ++i)
+  {
+    crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xff] ^ (crc >> 8);
+  }
+
+  return ~crc;
+}
+
+void WriteFixed(char * out, uint64_t value, size_t size)
+{
+  for (size_t i = 0; i < size; ++i)
+  {
+    out[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+  }
+}
+
+uint64_t ReadFixed(char const * in, size_t size)
+{
+  uint64_t value = 0;
+
+  for (size_t i = 0; i < size; ++i)
+  {
+    value |= static_cast<uint64_t>(static_cast<uint8_t>(in[i])) << (8 * i);
+  }
+
+  return value;
+}
+
+void Encode(ScoreRecord const & record, char * out)
+{
+  WriteFixed(out, record.m_level, 4);
+  WriteFixed(out + 4, record.m_score, 8);
+  WriteFixed(out + 12, record.m_time, 8);
+  WriteFixed(out + kPayloadSize, Crc32(out, kPayloadSize), 4);
+}
+
+bool Decode(char const * in, ScoreRecord & record)
+{
+  if (ReadFixed(in + kPayloadSize, 4) != Crc32(in, kPayloadSize))
+  {
+    return false;
+  }
+
+  record.m_level = static_cast<uint32_t>(ReadFixed(in, 4));
+  record.m_score = ReadFixed(in + 4, 8);
+  record.m_time = ReadFixed(in + 12, 8);
+
+  return true;
+}
+
+/// Flush the file from the OS cache to the disk.
+bool Sync(std::FILE * file)
+{
+#ifdef _WIN32
+  return _commit(_fileno(file)) == 0;
+#else
+  return fsync(fileno(file)) == 0;
+#endif
+}
+
+///
+/// Append the data with one write and wait for the disk.
+///
+/// Exception: WriteFileException.
+///
+void Append(std::string const & fileName, char const * data, size_t size)
+{
+  std::FILE * file = std::fopen(fileName.c_str(), "ab");
+
+  if (file == nullptr)
+  {
+    throw WriteFileException(fileName);
+  }
+
+  bool const isWritten = std::fwrite(data, 1, size, file) == size &&
+                         std::fflush(file) == 0 &&
+                         Sync(file);
+
+  if (std::fclose(file) != 0 || !isWritten)
+  {
+    throw WriteFileException(fileName);
+  }
+}
+
+///
+/// Cut the file to the size.
+///
+/// Exception: WriteFileException.
+///
+void Truncate(std::string const & fileName, uint64_t size)
+{
+  std::FILE * file = std::fopen(fileName.c_str(), "r+b");
+
+  if (file == nullptr)
+  {
+    throw WriteFileException(fileName);
+  }
+
+#ifdef _WIN32
+  bool const isTruncated = _chsize_s(_fileno(file), size) == 0 && Sync(file);
+#else
+  bool const isTruncated = ftruncate(fileno(file), static_cast<off_t>(size)) == 0 && Sync(file);
+#endif
+
+  if (std::fclose(file) != 0 || !isTruncated)
+  {
+    throw WriteFileException(fileName);
+  }
+}
+
+} // namespace
+
+size_t constexpr ScoreStore::kTopSize;
+
+void ScoreStore::Open(std::string const & fileName)
+{
+  // The store is open only once the file passed the check.
+  m_fileName.clear();
+  m_top.clear();
+  m_best.clear();
+  m_count = 0;
+  m_corrupted = 0;
+
+  std::ifstream ifs(fileName, std::ifstream::binary | std::ifstream::ate);
+
+  if (!ifs.is_open())
+  {
+    Append(fileName, kHeader, kHeaderSize);
+    m_fileName = fileName;
+    return;
+  }
+
+  uint64_t const fileSize = static_cast<uint64_t>(ifs.tellg());
+  ifs.seekg(0);
+
+  char header[kHeaderSize];
+  ifs.read(header, kHeaderSize);
+  size_t const headerSize = static_cast<size_t>(ifs.gcount());
+
+  if (std::memcmp(header, kHeader, headerSize) != 0)
+  {
+    throw ReadFileException(fileName);
+  }
+
+  // The file was created, but the header didn't reach the disk.
+  if (headerSize < kHeaderSize)
+  {
+    Truncate(fileName, 0);
+    Append(fileName, kHeader, kHeaderSize);
+    m_fileName = fileName;
+    return;
+  }
+
+  uint64_t validSize = kHeaderSize;
+  std::vector<char> buffer(kReadRecords * kRecordSize);
+
+  while (ifs)
+  {
+    ifs.read(buffer.data(), buffer.size());
+    size_t const records = static_cast<size_t>(ifs.gcount()) / kRecordSize;
+
+    for (size_t i = 0; i < records; ++i)
+    {
+      ScoreRecord record;
+
+      if (Decode(buffer.data() + i * kRecordSize, record))
+      {
+        Index(record);
+      }
+      else
+      {
+        ++m_corrupted;
+      }
+    }
+
+    validSize += records * kRecordSize;
+  }
+
+  ifs.close();
+
+  if (validSize < fileSize)
+  {
+    Truncate(fileName, validSize);
+  }
+
+  m_fileName = fileName;
+}
+
+void ScoreStore::Add(ScoreRecord const & record)
+{
+  // Records never go to a file which failed to open.
+  if (!IsOpen())
+  {
+    throw WriteFileException(m_fileName);
+  }
+
+  char data[kRecordSize];
+  Encode(record, data);
+
+  Append(m_fileName, data, kRecordSize);
+
+  Index(record);
+}
+
+bool ScoreStore::IsOpen() const
+{
+  return !m_fileName.empty();
+}
+
+std::vector<ScoreRecord> ScoreStore::GetTop() const
+{
+  std::vector<ScoreRecord> top(m_top);
+  std::sort(top.begin(), top.end(), &ScoreStore::IsBetter);
+
+  return top;
+}
+
+bool ScoreStore::IsBetter(ScoreRecord const & a, ScoreRecord const & b)
+{
+  if (a.m_score != b.m_score)
+  {
+    return a.m_score > b.m_score;
+  }
+
+  return a.m_time < b.m_time;
+}
+
+void ScoreStore::Index(ScoreRecord const & record)
+{
+  ++m_count;
+
+  if (m_top.size() < kTopSize)
+  {
+    m_top.push_back(record);
+    std::push_heap(m_top.begin(), m_top.end(), &ScoreStore::IsBetter);
+  }
+  else if (IsBetter(record, m_top.front()))
+  {
+    std::pop_heap(m_top.begin(), m_top.end(), &ScoreStore::IsBetter);
+    m_top.back() = record;
+    std::push_heap(m_top.begin(), m_top.end(), &ScoreStore::IsBetter);
+  }
+
+  auto const it = m_best.find(record.m_level);
+
+  if (it == m_best.end())
+  {
+    m_best.emplace(record.m_level, record);
+  }
+  else if (IsBetter(record, it->second))
+  {
+    it->second = record;
+  }
+}
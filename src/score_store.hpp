@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+struct ScoreRecord
+{
+  /// The level reached by the run.
+  uint32_t m_level = 1;
+  uint64_t m_score = 0;
+  /// Seconds since the epoch.
+  uint64_t m_time = 0;
+};
+
+///
+/// Persistent table of the finished games.
+///
+/// Every run is appended to a log of fixed size records with
+/// a checksum, the file is never rewritten. The index of the best runs
+/// is rebuilt in one sequential pass of the log on Open(),
+/// after that queries don't touch the file.
+///
+/// A record which failed the checksum is skipped. A torn record
+/// at the end of the file, left by a crash during a write,
+/// is cut off, so the next record starts at the right offset.
+///
+class ScoreStore
+{
+public:
+  /// Number of runs in the top list.
+  static size_t constexpr kTopSize = 10;
+
+  ScoreStore() = default;
+
+  ///
+  /// Load the log and build the index. A missing file is created.
+  /// If it throws, the store stays closed.
+  ///
+  /// Exception: ReadFileException, WriteFileException.
+  ///
+  void Open(std::string const & fileName);
+
+  ///
+  /// Append a run to the log and update the index.
+  /// The record is flushed to the disk before it returns.
+  ///
+  /// Exception: WriteFileException, also if the store isn't open.
+  ///
+  void Add(ScoreRecord const & record);
+
+  /// Whether the last Open() succeeded.
+  bool IsOpen() const;
+
+  /// The best runs, the best one is the first.
+  std::vector<ScoreRecord> GetTop() const;
+
+  /// The best run of every level which was played.
+  std::map<uint32_t, ScoreRecord> const & GetBestByLevel() const { return m_best; }
+
+  /// Number of runs in the log.
+  uint64_t GetCount() const { return m_count; }
+
+  /// Records skipped by the last Open() because of the checksum.
+  uint64_t GetCorrupted() const { return m_corrupted; }
+
+  ///
+  /// Order of the runs in the table. The higher score wins,
+  /// the earlier run wins for the same score.
+  ///
+  static bool IsBetter(ScoreRecord const & a, ScoreRecord const & b);
+
+private:
+  void Index(ScoreRecord const & record);
+
+  std::string m_fileName;
+
+  // Heap of the best runs, the worst of them is the first.
+  std::vector<ScoreRecord> m_top;
+
+  std::map<uint32_t, ScoreRecord> m_best;
+
+  uint64_t m_count = 0;
+  uint64_t m_corrupted = 0;
+};
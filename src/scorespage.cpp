@@ -1,12 +1,36 @@
 #include "scorespage.h"
 #include "ui_scorespage.h"
 
-ScoresPage::ScoresPage(QWidget *parent) :
+#include <QDateTime>
+
+ScoresPage::ScoresPage(QWidget *parent, ScoreStore const & scores) :
     QWidget(parent),
     ui(new Ui::ScoresPage)
 {
     ui->setupUi(this);
 
+    // The index is in memory, nothing is read from the disk here.
+    int place = 1;
+    for (auto const & record : scores.GetTop())
+    {
+        ui->scoresList->addItem(
+            QString("%1. %2    level %3    %4")
+                .arg(place++)
+                .arg(record.m_score)
+                .arg(record.m_level)
+                .arg(QDateTime::fromTime_t(record.m_time).toString("yyyy-MM-dd hh:mm")));
+    }
+
+    ui->scoresList->addItem(QString());
+
+    for (auto const & best : scores.GetBestByLevel())
+    {
+        ui->scoresList->addItem(
+            QString("Level %1 best: %2").arg(best.first).arg(best.second.m_score));
+    }
+
+    ui->scoresList->addItem(QString("Games played: %1").arg(scores.GetCount()));
+
     connect(this, SIGNAL(moveToMenuPage()),
             parent, SLOT(moveToMenuPage()));
 }
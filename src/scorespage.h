@@ -2,6 +2,8 @@
 
 #include <QWidget>
 
+#include "score_store.hpp"
+
 namespace Ui {
 class ScoresPage;
 }
@@ -11,7 +13,7 @@ class ScoresPage : public QWidget
  Q_OBJECT
 
  public:
-  explicit ScoresPage(QWidget *parent = 0);
+  ScoresPage(QWidget *parent, ScoreStore const & scores);
   ~ScoresPage();
 
  private slots:
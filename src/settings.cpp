@@ -7,19 +7,108 @@
 
 #include "util.hpp"
 #include "except.hpp"
+#include "json_stream.hpp"
+#include "memory_tracker.hpp"
+
+namespace
+{
+
+///
+/// Exception: ReadSettingsException.
+///
+WavePattern ReadPattern(std::string const & name)
+{
+  if (name == "Grid")
+  {
+    return WavePattern::Grid;
+  }
+  if (name == "Wedge")
+  {
+    return WavePattern::Wedge;
+  }
+
+  throw ReadSettingsException(Globals::SettingsFileName);
+}
+
+///
+/// Exception: ReadSettingsException.
+///
+WavePath ReadPath(std::string const & name)
+{
+  if (name == "None")
+  {
+    return WavePath::None;
+  }
+  if (name == "Straight")
+  {
+    return WavePath::Straight;
+  }
+  if (name == "Swoop")
+  {
+    return WavePath::Swoop;
+  }
+
+  throw ReadSettingsException(Globals::SettingsFileName);
+}
+
+///
+/// Aliens of a wave take the level parameters which aren't given.
+///
+/// Exception: ReadSettingsException.
+///
+WaveParameters ReadWave(Json::Value const & wave, AlienParameters const & aliens)
+{
+  WaveParameters parameters;
+
+  parameters.m_time = wave.get("Time", 0.0f).asFloat();
+  parameters.m_interval = wave.get("Interval", 0.0f).asFloat();
+
+  parameters.m_pattern = ReadPattern(wave.get("Pattern", "Grid").asString());
+  parameters.m_columns = wave.get("Columns", 0).asUInt();
+  parameters.m_rows = wave.get("Rows", 1).asUInt();
+  parameters.m_x = wave.get("X", 0.0f).asFloat();
+  parameters.m_y = wave.get("Y", 0.0f).asFloat();
+  parameters.m_spacingX = wave.get("SpacingX", aliens.m_size.first).asFloat();
+  parameters.m_spacingY = wave.get("SpacingY", aliens.m_size.second).asFloat();
+
+  parameters.m_health = wave.get("Health", aliens.m_health).asInt();
+  parameters.m_frequency = wave.get("Frequency", aliens.m_frequency).asUInt();
+  parameters.m_size = std::make_pair(
+      wave.get("Width", aliens.m_size.first).asInt(),
+      wave.get("Height", aliens.m_size.second).asInt());
+
+  parameters.m_path = ReadPath(wave.get("Path", "None").asString());
+  parameters.m_pathTime = wave.get("PathTime", 0.0f).asFloat();
+  parameters.m_entryX = wave.get("EntryX", 0.0f).asFloat();
+  parameters.m_entryY = wave.get("EntryY", 0.0f).asFloat();
+
+  return parameters;
+}
+
+} // namespace
 
 void Settings::LoadMainSettings()
 {
+  MemoryScope scope(MemoryTag::Settings);
+
   Json::Value settings;
 
   try
   {
-    settings = Util::ReadJson(Globals::SettingsFileName);
+    settings = ReadSettings();
 
     // MainParameters.
     m_mainParameters.m_difficulty = settings["Difficulty"].asUInt();
     m_mainParameters.m_speed = settings["Speed"].asUInt();
     m_mainParameters.m_levelsNumber = settings["LevelsNumber"].asUInt();
+    m_mainParameters.m_seed = settings.get("Seed", 1).asUInt();
+    m_mainParameters.m_fixedStep = settings.get("FixedStep", true).asBool();
+    m_mainParameters.m_recordReplay = settings.get("RecordReplay", false).asBool();
+    m_mainParameters.m_jobThreads = settings.get("JobThreads", 0).asUInt();
+    m_mainParameters.m_renderThread = settings.get("RenderThread", true).asBool();
+    m_mainParameters.m_spawnBudget = settings.get("SpawnBudget", 64).asUInt();
+    m_mainParameters.m_particleCapacity = settings.get("ParticleCapacity", 4096).asUInt();
+    m_mainParameters.m_textureBudget = settings.get("TextureBudgetKB", 65536).asUInt();
 
     // StarParameters
     m_starParameters.m_number = settings["StarNumber"].asUInt();
@@ -38,6 +127,23 @@ void Settings::LoadMainSettings()
     m_explosionParameters.m_sizeBig = std::make_pair(
         settings["ExplosionWidthBig"].asInt(),
         settings["ExplosionHeightBig"].asInt());
+
+    m_explosionParameters.m_particles = settings.get("ExplosionParticles", 8).asUInt();
+    m_explosionParameters.m_speed = settings.get("ExplosionSpeed", 120.0f).asFloat();
+
+    // Texture upload by assets.
+    Json::Value const & textures = settings["Textures"];
+    for (auto const & name : textures.getMemberNames())
+    {
+      Json::Value const & texture = textures[name];
+      TextureParameters & parameters = m_textureParameters[name];
+
+      parameters.m_mipmaps = texture.get("Mipmaps", true).asBool();
+      parameters.m_format = texture.get("Format", "RGBA8").asString() == "DXT5"
+          ? TextureFormat::DXT5
+          : TextureFormat::RGBA8;
+      parameters.m_cache = texture.get("Cache", false).asBool();
+    }
   }
   catch(ReadFileException const & ex)
   {
@@ -47,52 +153,70 @@ void Settings::LoadMainSettings()
 
 void Settings::LoadLevelSettings(std::string const & level)
 {
+  MemoryScope scope(MemoryTag::Settings);
+
   Json::Value settings;
 
   try
   {
-    settings = Util::ReadJson(Globals::SettingsFileName);
+    // Only this level is parsed, a level pack can be large.
+    settings = JsonStream::Read(Globals::SettingsFileName, { "Level", level });
+
+    Json::Value const userSettings = ReadUserSettings();
+    if (userSettings["Level"].isMember(level))
+    {
+      Util::MergeJson(settings, userSettings["Level"][level]);
+    }
 
     /// Alien parameters.
-    m_alienParameters.m_number = settings["Level"][level]["AliensNumber"].asUInt();
-    m_alienParameters.m_speed = settings["Level"][level]["AlienSpeed"].asInt();
-    m_alienParameters.m_rate = settings["Level"][level]["AlienRate"].asUInt();
-    m_alienParameters.m_health = settings["Level"][level]["AlienHealth"].asInt();
+    m_alienParameters.m_number = settings["AliensNumber"].asUInt();
+    m_alienParameters.m_speed = settings["AlienSpeed"].asInt();
+    m_alienParameters.m_rate = settings["AlienRate"].asUInt();
+    m_alienParameters.m_health = settings["AlienHealth"].asInt();
 
     m_alienParameters.m_size = std::make_pair(
-        settings["Level"][level]["AlienWidth"].asInt(),
-        settings["Level"][level]["AlienHeigth"].asInt());
+        settings["AlienWidth"].asInt(),
+        settings["AlienHeigth"].asInt());
 
-    m_alienParameters.m_rowNumber = settings["Level"][level]["AlienRowNumber"].asUInt();
-    m_alienParameters.m_frequency = settings["Level"][level]["AlienFrequency"].asUInt();
-    m_alienParameters.m_score = settings["Level"][level]["AlienScore"].asUInt();
+    m_alienParameters.m_rowNumber = settings["AlienRowNumber"].asUInt();
+    m_alienParameters.m_frequency = settings["AlienFrequency"].asUInt();
+    m_alienParameters.m_score = settings["AlienScore"].asUInt();
+    m_alienParameters.m_stepDown = settings.get("AlienStepDown", 0).asInt();
 
     /// Bullet parameters.
-    m_bulletParameters.m_damage = settings["Level"][level]["BulletDamage"].asUInt();
+    m_bulletParameters.m_damage = settings["BulletDamage"].asUInt();
 
     m_bulletParameters.m_size = std::make_pair(
-        settings["Level"][level]["BulletWidth"].asInt(),
-        settings["Level"][level]["BulletHeight"].asInt());
+        settings["BulletWidth"].asInt(),
+        settings["BulletHeight"].asInt());
 
     /// Space Ship parameters.
-    m_spaceShipParameters.m_health = settings["Level"][level]["SpaceShipHealth"].asInt();
-    m_spaceShipParameters.m_speed = settings["Level"][level]["SpaceShipSpeed"].asUInt();
+    m_spaceShipParameters.m_health = settings["SpaceShipHealth"].asInt();
+    m_spaceShipParameters.m_speed = settings["SpaceShipSpeed"].asUInt();
 
     m_spaceShipParameters.m_size = std::make_pair(
-        settings["Level"][level]["SpaceShipWidth"].asInt(),
-        settings["Level"][level]["SpaceShipHeigth"].asInt());
+        settings["SpaceShipWidth"].asInt(),
+        settings["SpaceShipHeigth"].asInt());
 
-    m_spaceShipParameters.m_rate = settings["Level"][level]["SpaceShipRate"].asUInt();
+    m_spaceShipParameters.m_rate = settings["SpaceShipRate"].asUInt();
 
     /// Obstacle parameters.
-    m_obstacleParameters.m_number = settings["Level"][level]["ObstacleNumber"].asUInt();
-    m_obstacleParameters.m_health = settings["Level"][level]["ObstacleHealth"].asInt();
+    m_obstacleParameters.m_number = settings["ObstacleNumber"].asUInt();
+    m_obstacleParameters.m_health = settings["ObstacleHealth"].asInt();
 
     m_obstacleParameters.m_size = std::make_pair(
-        settings["Level"][level]["ObstacleWidth"].asInt(),
-        settings["Level"][level]["ObstacleHeigth"].asInt());
+        settings["ObstacleWidth"].asInt(),
+        settings["ObstacleHeigth"].asInt());
+
+    m_obstacleParameters.m_score = settings["ObstacleScore"].asUInt();
+
+    /// Waves.
+    m_waves.clear();
 
-    m_obstacleParameters.m_score = settings["Level"][level]["ObstacleScore"].asUInt();
+    for (auto const & wave : settings["Waves"])
+    {
+      m_waves.push_back(ReadWave(wave, m_alienParameters));
+    }
   }
   catch(ReadFileException const & ex)
   {
@@ -105,4 +229,42 @@ void Settings::LoadLevelSettings(std::string const & level)
   m_spaceShipParameters.m_speed *= m_mainParameters.m_speed;
   // Difficulty.
   m_alienParameters.m_rate *= m_mainParameters.m_difficulty;
-}
\ No newline at end of file
+}
+
+Json::Value Settings::ReadSettings()
+{
+  // Levels are loaded one by one.
+  Json::Value settings = JsonStream::ReadMembers(Globals::SettingsFileName, { "Level" });
+
+  Util::MergeJson(settings, ReadUserSettings());
+
+  return settings;
+}
+
+void Settings::SaveUserSettings(Json::Value const & values)
+{
+  Json::Value userSettings = ReadUserSettings();
+
+  Util::MergeJson(userSettings, values);
+
+  Util::WriteJsonAtomic(Globals::UserSettingsFileName, userSettings);
+}
+
+Json::Value Settings::ReadUserSettings()
+{
+  try
+  {
+    Json::Value userSettings = Util::ReadJson(Globals::UserSettingsFileName);
+
+    if (userSettings.isObject())
+    {
+      return userSettings;
+    }
+  }
+  catch (std::exception const & ex)
+  {
+    // The defaults from the settings file are used.
+  }
+
+  return Json::Value(Json::objectValue);
+}
@@ -1,16 +1,12 @@
 #pragma once
 
+#include "json/value.h"
+
 #include "singleton.h"
 #include "game_entity.hpp"
-#include "bullet_parameters.hpp"
-#include "explosion_parameters.hpp"
-#include "alien_parameters.h"
-#include "star_parameters.h"
-#include "space_ship_parameters.h"
-#include "obstacle_parameters.h"
-#include "main_parameters.hpp"
-
-class Settings : public Singleton<Settings>
+#include "game_parameters.hpp"
+
+class Settings : public Singleton<Settings>, public GameParameters
 {
 public:
   ///
@@ -27,30 +23,32 @@ public:
   ///
   void LoadLevelSettings(const std::string & level);
 
-  /// Main parameters.
-  MainParameters m_mainParameters;
-
-  /// Star parameters.
-  StarParameters m_starParameters;
-
-  /// Explosion parameters.
-  ExplosionParameters m_explosionParameters;
-
-  /// Alien parameters.
-  AlienParameters m_alienParameters;
-
-  /// Bullet parameters.
-  BulletParameters m_bulletParameters;
-
-  /// Space Ship parameters.
-  SpaceShipParameters m_spaceShipParameters;
+  ///
+  /// Read the settings file without the level data
+  /// and with the user preferences on top of it.
+  ///
+  /// Exception: ReadFileException.
+  ///
+  static Json::Value ReadSettings();
 
-  /// Obstacle parameters.
-  ObstacleParameters m_obstacleParameters;
+  ///
+  /// Store the values to the user preferences.
+  ///
+  /// Other preferences are kept. The settings file with the level data
+  /// is never written, so a crash can't damage it.
+  ///
+  /// Exception: WriteFileException.
+  ///
+  static void SaveUserSettings(Json::Value const & values);
 
 private:
   /// Otherwise it won't be accessible in parent class Singleton<Settings>.
   friend class Singleton<Settings>;
 
   Settings() = default;
+
+  ///
+  /// The user preferences. A missing or broken file gives an empty object.
+  ///
+  static Json::Value ReadUserSettings();
 };
@@ -9,8 +9,8 @@
 
 #include <QDebug>
 
-#include "util.hpp"
-#include "constants.hpp"
+#include "settings.hpp"
+#include "except.hpp"
 
 SettingsPage::SettingsPage(QWidget *parent) :
   QWidget(parent),
@@ -39,7 +39,7 @@ SettingsPage::SettingsPage(QWidget *parent) :
   {
     Json::Value settings;
 
-    settings = Util::ReadJson(Globals::SettingsFileName);
+    settings = Settings::ReadSettings();
 
     int currentDifficulty = settings["Difficulty"].asInt();
     int currentSpeed = settings["Speed"].asInt();
@@ -76,12 +76,19 @@ void SettingsPage::on_saveButton_clicked()
   currentDifficulty++;
   currentSpeed++;
 
-  Json::Value settings = Util::ReadJson(Globals::SettingsFileName);
+  Json::Value settings;
 
   settings["Difficulty"] = currentDifficulty;
   settings["Speed"] = currentSpeed;
 
-  Util::WriteJson(Globals::SettingsFileName, settings);
+  try
+  {
+    Settings::SaveUserSettings(settings);
+  }
+  catch (WriteFileException const & ex)
+  {
+    qDebug() << ex.what();
+  }
 
   emit moveToMenuPage();
 }
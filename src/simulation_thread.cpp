@@ -0,0 +1,116 @@
+#include "simulation_thread.hpp"
+
+#include <chrono>
+
+namespace
+{
+
+// Don't try to catch up after long stalls.
+int constexpr kMaxLateTicks = 5;
+
+} // namespace
+
+SimulationThread::SimulationThread(World & world)
+  : m_world(world),
+    m_isRunning(false)
+{
+  // Something to draw before the first step.
+  m_renderLists.GetWriteBuffer().Build(m_world);
+  m_renderLists.Publish();
+}
+
+SimulationThread::~SimulationThread()
+{
+  Stop();
+}
+
+void SimulationThread::Start()
+{
+  if (m_isRunning)
+  {
+    return;
+  }
+
+  m_isRunning = true;
+  m_thread = std::thread(&SimulationThread::Loop, this);
+}
+
+void SimulationThread::Stop()
+{
+  m_isRunning = false;
+
+  if (m_thread.joinable())
+  {
+    m_thread.join();
+  }
+
+  // Tasks which came after the last step.
+  RunTasks();
+}
+
+bool SimulationThread::IsRunning() const
+{
+  return m_isRunning;
+}
+
+void SimulationThread::Post(TTask const & task)
+{
+  std::lock_guard<std::mutex> lock(m_tasksMutex);
+  m_tasks.push_back(task);
+}
+
+RenderList const & SimulationThread::AcquireRenderList()
+{
+  m_renderLists.Update();
+
+  return m_renderLists.GetReadBuffer();
+}
+
+void SimulationThread::Loop()
+{
+  using TClock = std::chrono::steady_clock;
+
+  auto const step = std::chrono::duration_cast<TClock::duration>(
+        std::chrono::duration<float>(World::kFixedTimeStep));
+
+  auto next = TClock::now();
+
+  while (m_isRunning)
+  {
+    RunTasks();
+
+    if (m_world.GetGameState() == GameState::RUNINIG)
+    {
+      m_world.Tick(World::kFixedTimeStep);
+    }
+
+    m_renderLists.GetWriteBuffer().Build(m_world);
+    m_renderLists.Publish();
+
+    next += step;
+
+    auto const now = TClock::now();
+
+    if (now - next > kMaxLateTicks * step)
+    {
+      next = now;
+    }
+
+    std::this_thread::sleep_until(next);
+  }
+}
+
+void SimulationThread::RunTasks()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_tasksMutex);
+    m_runningTasks.swap(m_tasks);
+  }
+
+  for (auto const & task : m_runningTasks)
+  {
+    task(m_world);
+  }
+
+  m_runningTasks.clear();
+}
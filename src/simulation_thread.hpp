@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "world.hpp"
+#include "render_list.hpp"
+#include "triple_buffer.hpp"
+
+///
+/// It runs the game logic with the fixed step on its own thread.
+///
+/// After every step the state is copied to a render list, and the GL
+/// thread draws the newest list without waiting for the simulation.
+/// While the thread runs, the world must only be used by posted tasks.
+///
+class SimulationThread
+{
+public:
+  using TTask = std::function<void(World & world)>;
+
+  explicit SimulationThread(World & world);
+  ~SimulationThread();
+
+  SimulationThread(SimulationThread const &) = delete;
+  SimulationThread & operator=(SimulationThread const &) = delete;
+
+  void Start();
+
+  ///
+  /// Wait for the thread. Afterwards the world can be used directly.
+  ///
+  void Stop();
+
+  bool IsRunning() const;
+
+  ///
+  /// Run a task on the simulation thread before the next step.
+  /// Tasks run in the order they are posted.
+  ///
+  void Post(TTask const & task);
+
+  ///
+  /// The newest state of the game. It is called by one consumer thread.
+  ///
+  RenderList const & AcquireRenderList();
+
+private:
+  void Loop();
+  void RunTasks();
+
+  World & m_world;
+
+  std::thread m_thread;
+  std::atomic<bool> m_isRunning;
+
+  std::mutex m_tasksMutex;
+  std::vector<TTask> m_tasks;
+
+  // Tasks taken from the queue, they run without the lock.
+  std::vector<TTask> m_runningTasks;
+
+  TripleBuffer<RenderList> m_renderLists;
+};
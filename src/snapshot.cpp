@@ -0,0 +1,68 @@
+#include "snapshot.hpp"
+
+namespace
+{
+
+uint64_t constexpr kHashOffset = 14695981039346656037ULL;
+uint64_t constexpr kHashPrime = 1099511628211ULL;
+
+/// Finalizer of MurmurHash3, it spreads every input bit over the result.
+uint64_t Mix(uint64_t value)
+{
+  value ^= value >> 33;
+  value *= 0xff51afd7ed558ccdULL;
+  value ^= value >> 33;
+  value *= 0xc4ceb9fe1a85ec53ULL;
+  value ^= value >> 33;
+  return value;
+}
+
+} // namespace
+
+void Snapshot::Clear()
+{
+  m_data.clear();
+  m_readPosition = 0;
+}
+
+void Snapshot::Rewind()
+{
+  m_readPosition = 0;
+}
+
+size_t Snapshot::Size() const
+{
+  return m_data.size();
+}
+
+unsigned char const * Snapshot::Data() const
+{
+  return m_data.data();
+}
+
+uint64_t Snapshot::Hash() const
+{
+  uint64_t hash = kHashOffset;
+
+  // Hash eight bytes at a time, the tail byte by byte.
+  size_t const words = m_data.size() / sizeof(uint64_t);
+
+  for (size_t i = 0; i < words; ++i)
+  {
+    uint64_t word;
+    std::memcpy(&word, m_data.data() + i * sizeof(uint64_t), sizeof(uint64_t));
+    hash = (hash ^ word) * kHashPrime;
+  }
+
+  for (size_t i = words * sizeof(uint64_t); i < m_data.size(); ++i)
+  {
+    hash = (hash ^ m_data[i]) * kHashPrime;
+  }
+
+  return Mix(hash ^ m_data.size());
+}
+
+uint64_t Snapshot::Combine(uint64_t seed, uint64_t hash)
+{
+  return Mix(seed * kHashPrime + hash);
+}
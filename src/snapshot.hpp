@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "except.hpp"
+
+///
+/// Compact binary image of the game state.
+///
+/// Values are copied as raw bytes, so a snapshot is only valid
+/// for the same build. Clear() keeps the memory, so taking
+/// a snapshot every tick doesn't allocate in the steady state.
+///
+class Snapshot
+{
+public:
+  Snapshot() = default;
+
+  void Clear();
+
+  /// Move the read position to the beginning.
+  void Rewind();
+
+  template<typename T>
+  void Write(T const & value)
+  {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable values can be stored.");
+
+    size_t const position = m_data.size();
+    m_data.resize(position + sizeof(T));
+    std::memcpy(m_data.data() + position, &value, sizeof(T));
+  }
+
+  ///
+  /// Exception: ReadSnapshotException.
+  ///
+  template<typename T>
+  void Read(T & value)
+  {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable values can be restored.");
+
+    if (m_readPosition + sizeof(T) > m_data.size())
+    {
+      throw ReadSnapshotException();
+    }
+
+    std::memcpy(&value, m_data.data() + m_readPosition, sizeof(T));
+    m_readPosition += sizeof(T);
+  }
+
+  template<typename T>
+  T Read()
+  {
+    T value;
+    Read(value);
+    return value;
+  }
+
+  size_t Size() const;
+
+  unsigned char const * Data() const;
+
+  ///
+  /// Hash of the stored bytes.
+  ///
+  uint64_t Hash() const;
+
+  ///
+  /// Combine two hashes, the order matters.
+  ///
+  static uint64_t Combine(uint64_t seed, uint64_t hash);
+
+private:
+  std::vector<unsigned char> m_data;
+  size_t m_readPosition = 0;
+};
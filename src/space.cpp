@@ -1,6 +1,61 @@
 #include "space.hpp"
 #include "constants.hpp"
 
+namespace
+{
+
+template<typename T>
+void Spawn(std::list<std::shared_ptr<T>> & list,
+           std::list<std::shared_ptr<T>> & pool,
+           T const & entity)
+{
+  if (pool.empty())
+  {
+    list.push_back(std::make_shared<T>(entity));
+    return;
+  }
+
+  *pool.front() = entity;
+  list.splice(list.end(), pool, pool.begin());
+}
+
+template<typename T>
+typename std::list<T>::iterator Release(std::list<T> & list,
+                                        std::list<T> & pool,
+                                        typename std::list<T>::iterator it)
+{
+  auto next = std::next(it);
+  pool.splice(pool.end(), list, it);
+  return next;
+}
+
+template<typename T>
+void ReleaseMarked(std::list<T> & list,
+                   std::list<T> & pool,
+                   std::vector<uint8_t> const & removed)
+{
+  size_t i = 0;
+
+  for (auto it = begin(list); it != end(list); ++i)
+  {
+    it = removed[i] ? Release(list, pool, it) : std::next(it);
+  }
+}
+
+template<typename T>
+void EraseMarked(std::list<T> & list,
+                 std::vector<uint8_t> const & removed)
+{
+  size_t i = 0;
+
+  for (auto it = begin(list); it != end(list); ++i)
+  {
+    it = removed[i] ? list.erase(it) : std::next(it);
+  }
+}
+
+} // namespace
+
 std::list<TAlienPtr> &Space::GetAliens()
 {
   return m_alienList;
@@ -61,9 +116,54 @@ void Space::SetSpaceShip(TSpaceShipPtr spaceShip)
   m_space_ship = spaceShip;
 }
 
-void Space::AddExplosion(TExplosionPtr explosion)
+void Space::SpawnAlienBullet(Bullet const & bullet)
+{
+  Spawn(m_alienBulletList, m_alienBulletPool, bullet);
+}
+
+void Space::SpawnSpaceShipBullet(Bullet const & bullet)
+{
+  Spawn(m_spaceShipBulletList, m_spaceShipBulletPool, bullet);
+}
+
+std::list<TBulletPtr>::iterator Space::RemoveAlienBullet(std::list<TBulletPtr>::iterator it)
 {
-  m_explosionList.push_back(explosion);
+  return Release(m_alienBulletList, m_alienBulletPool, it);
+}
+
+std::list<TBulletPtr>::iterator Space::RemoveSpaceShipBullet(std::list<TBulletPtr>::iterator it)
+{
+  return Release(m_spaceShipBulletList, m_spaceShipBulletPool, it);
+}
+
+void Space::RemoveAliens(std::vector<uint8_t> const & removed)
+{
+  EraseMarked(m_alienList, removed);
+}
+
+void Space::RemoveObstacles(std::vector<uint8_t> const & removed)
+{
+  EraseMarked(m_obstacleList, removed);
+}
+
+void Space::RemoveAlienBullets(std::vector<uint8_t> const & removed)
+{
+  ReleaseMarked(m_alienBulletList, m_alienBulletPool, removed);
+}
+
+void Space::RemoveSpaceShipBullets(std::vector<uint8_t> const & removed)
+{
+  ReleaseMarked(m_spaceShipBulletList, m_spaceShipBulletPool, removed);
+}
+
+void Space::Clear()
+{
+  m_alienList.clear();
+  m_obstacleList.clear();
+  m_starList.clear();
+
+  m_alienBulletPool.splice(m_alienBulletPool.end(), m_alienBulletList);
+  m_spaceShipBulletPool.splice(m_spaceShipBulletPool.end(), m_spaceShipBulletList);
 }
 
 Space::~Space()
@@ -77,9 +177,3 @@ std::ostream & operator << (std::ostream & os,
   os << "Space";
   return os;
 }
-
-
-std::list<TExplosionPtr> &Space::GetExplosions()
-{
-  return m_explosionList;
-}
@@ -1,11 +1,12 @@
 #pragma once
 
 #include <list>
+#include <memory>
+#include <vector>
 #include "alien.hpp"
 #include "space_ship.hpp"
 #include "obstacle.hpp"
 #include "star.hpp"
-#include "explosion.hpp"
 
 class Space
 {
@@ -20,7 +21,6 @@ public:
   std::list<TBulletPtr> & GetAlienBullets();
   std::list<TBulletPtr> & GetSpaceShipBullets();
   TSpaceShipPtr const & GetSpaceShip() const;
-  std::list<TExplosionPtr> & GetExplosions();
 
   void AddAlien(TAlienPtr alien);
   void AddObstacle(TObstaclePtr obstacle);
@@ -28,16 +28,108 @@ public:
   void AddAlienBullet(TBulletPtr bullet);
   void AddSpaceShipBullet(TBulletPtr bullet);
   void SetSpaceShip(TSpaceShipPtr spaceShip);
-  void AddExplosion(TExplosionPtr explosion);
-  
+
+  ///
+  /// Add a copy of the entity. The copy reuses a removed entity
+  /// and its list node if the pool has one.
+  ///
+  void SpawnAlienBullet(Bullet const & bullet);
+  void SpawnSpaceShipBullet(Bullet const & bullet);
+
+  ///
+  /// Add count copies of the prototype to the end of the list.
+  ///
+  /// The entities are constructed in place in one memory block, then
+  /// the generator sets up every one of them in order:
+  /// generator(size_t index, T & entity). The block is freed
+  /// when the last of its entities is removed.
+  ///
+  template<typename TGenerator>
+  void SpawnAliens(size_t count, Alien const & prototype, TGenerator const & generator)
+  {
+    SpawnBlock(m_alienList, count, prototype, generator);
+  }
+
+  template<typename TGenerator>
+  void SpawnObstacles(size_t count, Obstacle const & prototype, TGenerator const & generator)
+  {
+    SpawnBlock(m_obstacleList, count, prototype, generator);
+  }
+
+  template<typename TGenerator>
+  void SpawnStars(size_t count, Star const & prototype, TGenerator const & generator)
+  {
+    SpawnBlock(m_starList, count, prototype, generator);
+  }
+
+  ///
+  /// Remove one entity and return the next one.
+  /// The entity is moved to the pool.
+  ///
+  std::list<TBulletPtr>::iterator RemoveAlienBullet(std::list<TBulletPtr>::iterator it);
+  std::list<TBulletPtr>::iterator RemoveSpaceShipBullet(std::list<TBulletPtr>::iterator it);
+
+  ///
+  /// Remove the entities which are marked in the list order.
+  ///
+  /// Bullets are moved to the pools. Aliens and obstacles leave the list,
+  /// but they stay in their spawn block until the last entity of the block
+  /// is removed, see SpawnBlock().
+  ///
+  void RemoveAliens(std::vector<uint8_t> const & removed);
+  void RemoveObstacles(std::vector<uint8_t> const & removed);
+  void RemoveAlienBullets(std::vector<uint8_t> const & removed);
+  void RemoveSpaceShipBullets(std::vector<uint8_t> const & removed);
+
+  ///
+  /// Remove all entities but the space ship.
+  /// Bullets are moved to the pools, so the next game reuses them.
+  ///
+  void Clear();
+
 private:
+  ///
+  /// Every entity of the block is an alias of the block pointer, so
+  /// a removed entity is neither destroyed nor freed on its own. The
+  /// memory of the whole block is kept until its last entity leaves
+  /// the list, e.g. a formation which is shot down to one alien
+  /// holds all of it.
+  ///
+  template<typename T, typename TGenerator>
+  static void SpawnBlock(std::list<std::shared_ptr<T>> & list,
+                         size_t count,
+                         T const & prototype,
+                         TGenerator const & generator)
+  {
+    if (count == 0)
+    {
+      return;
+    }
+
+    auto const block = std::make_shared<std::vector<T>>(count, prototype);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      T & entity = (*block)[i];
+      generator(i, entity);
+
+      // The pointer shares the ownership of the whole block.
+      list.emplace_back(block, &entity);
+    }
+  }
+
   std::list<TAlienPtr> m_alienList;
   TSpaceShipPtr m_space_ship = nullptr;
   std::list<TObstaclePtr> m_obstacleList;
   std::list<TStarPtr> m_starList;
   std::list<TBulletPtr> m_spaceShipBulletList;
   std::list<TBulletPtr> m_alienBulletList;
-  std::list<TExplosionPtr> m_explosionList;
+
+  // Removed entities which are reused by the spawn methods.
+  // Every list has its own pool, so the stages which work
+  // with different lists can run in parallel.
+  std::list<TBulletPtr> m_spaceShipBulletPool;
+  std::list<TBulletPtr> m_alienBulletPool;
 };
 
 std::ostream & operator << (std::ostream & os,
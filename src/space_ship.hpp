@@ -20,16 +20,20 @@ public:
   SpaceShip(QVector2D const & position,
             uint const & rate,
             int const & health,
-            std::shared_ptr<QImage> image,
             TSize const & size)
     : GameEntityWithWeapon(
-      position,"SpaceShip", rate, health, image, size)
+      position,"SpaceShip", rate, health, size)
   {}
 
   ~SpaceShip() override;
 
   void Update() override;
   void Move() override;
+
+  using GameEntity::IncreaseY;
+  using GameEntity::DecreaseY;
+  using GameEntity::IncreaseX;
+  using GameEntity::DecreaseX;
 };
 
 using TSpaceShipPtr = std::shared_ptr<SpaceShip>;
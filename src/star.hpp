@@ -14,9 +14,8 @@ public:
   {}
 
   Star(QVector2D const & position,
-       std::shared_ptr<QImage> image,
        TSize const & size)
-    : GameEntity(position, "Star", image, size)
+    : GameEntity(position, "Star", size)
   {}
 
   ~Star() override;
@@ -0,0 +1,278 @@
+#include "texture_manager.hpp"
+
+#include <QDebug>
+#include <QDir>
+#include <QOpenGLContext>
+
+#include <algorithm>
+
+#include "constants.hpp"
+#include "except.hpp"
+
+namespace
+{
+
+size_t constexpr kAssetCount = static_cast<size_t>(RenderAsset::Count);
+
+// Textures are created and destroyed on the GL thread only.
+std::array<TextureStats, kAssetCount> g_stats;
+
+char const * const kNames[kAssetCount] =
+{
+  "Alien", "SpaceShip", "Bullet", "AlienBullet", "Obstacle", "Explosion", "Star"
+};
+
+} // namespace
+
+TextureManager::TextureManager(size_t budget)
+  : m_budget(budget)
+{}
+
+std::shared_ptr<QOpenGLTexture> TextureManager::Acquire(RenderAsset asset,
+                                                        QImage const & image,
+                                                        TextureParameters const & parameters)
+{
+  size_t const index = static_cast<size_t>(asset);
+
+  if (m_textures[index] != nullptr)
+  {
+    return m_textures[index];
+  }
+
+  TextureParameters upload = parameters;
+  if (!IsSupported(upload.m_format))
+  {
+    qDebug() << "Texture" << GetName(asset) << "is uploaded uncompressed,"
+             << "the format isn't supported.";
+
+    upload.m_format = TextureFormat::RGBA8;
+  }
+
+  int width = image.width();
+  int height = image.height();
+  size_t bytes = EstimateBytes(width, height, upload);
+
+  // Each halving takes a quarter of the memory. The smallest texture is uploaded anyway.
+  size_t const used = GetTotal().m_bytes;
+  while (m_budget > 0 && used + bytes > m_budget && (width > 1 || height > 1))
+  {
+    width = std::max(width / 2, 1);
+    height = std::max(height / 2, 1);
+    bytes = EstimateBytes(width, height, upload);
+  }
+
+  TexturePayload payload;
+  if (width != image.width() || height != image.height())
+  {
+    qDebug() << "Texture" << GetName(asset) << "is reduced to"
+             << width << "x" << height << "to fit the budget.";
+
+    payload = LoadPayload(asset,
+                          image.scaled(width, height, Qt::IgnoreAspectRatio, Qt::SmoothTransformation),
+                          upload);
+  }
+  else
+  {
+    payload = LoadPayload(asset, image, upload);
+  }
+
+  QOpenGLTexture * texture = Upload(payload);
+
+  bytes = payload.GetBytes();
+
+  g_stats[index].m_count++;
+  g_stats[index].m_bytes += bytes;
+
+  m_textures[index] = std::shared_ptr<QOpenGLTexture>(texture, [index, bytes](QOpenGLTexture * texture)
+  {
+    g_stats[index].m_count--;
+    g_stats[index].m_bytes -= bytes;
+    delete texture;
+  });
+
+  return m_textures[index];
+}
+
+std::shared_ptr<QOpenGLTexture> const & TextureManager::Get(RenderAsset asset) const
+{
+  return m_textures[static_cast<size_t>(asset)];
+}
+
+void TextureManager::Clear()
+{
+  for (auto & texture : m_textures)
+  {
+    texture.reset();
+  }
+}
+
+size_t TextureManager::GetBudget() const
+{
+  return m_budget;
+}
+
+void TextureManager::SetBudget(size_t budget)
+{
+  m_budget = budget;
+}
+
+TextureStats TextureManager::GetStats(RenderAsset asset)
+{
+  return g_stats[static_cast<size_t>(asset)];
+}
+
+TextureStats TextureManager::GetTotal()
+{
+  TextureStats total;
+
+  for (auto const & stats : g_stats)
+  {
+    total.m_count += stats.m_count;
+    total.m_bytes += stats.m_bytes;
+  }
+
+  return total;
+}
+
+char const * TextureManager::GetName(RenderAsset asset)
+{
+  size_t const index = static_cast<size_t>(asset);
+  return index < kAssetCount ? kNames[index] : "Unknown";
+}
+
+size_t TextureManager::EstimateBytes(int width, int height, TextureParameters const & parameters)
+{
+  size_t bytes = 0;
+  int const levels = parameters.m_mipmaps ? TexturePayload::GetMipLevels(width, height) : 1;
+
+  for (int i = 0; i < levels; ++i)
+  {
+    bytes += TexturePayload::GetLevelSize(width, height, parameters.m_format);
+
+    width = std::max(width / 2, 1);
+    height = std::max(height / 2, 1);
+  }
+
+  return bytes;
+}
+
+bool TextureManager::IsSupported(TextureFormat format)
+{
+  if (format == TextureFormat::RGBA8)
+  {
+    return true;
+  }
+
+  QOpenGLContext const * context = QOpenGLContext::currentContext();
+  return context != nullptr && context->hasExtension("GL_EXT_texture_compression_s3tc");
+}
+
+TexturePayload TextureManager::LoadPayload(RenderAsset asset,
+                                           QImage const & image,
+                                           TextureParameters const & parameters)
+{
+  // Rows of RGBA8888 are never padded.
+  QImage const pixels = image.convertToFormat(QImage::Format_RGBA8888);
+
+  int const width = pixels.width();
+  int const height = pixels.height();
+  size_t const levels = parameters.m_mipmaps ? TexturePayload::GetMipLevels(width, height) : 1;
+
+  std::string const fileName = Globals::TextureCacheDirectory + "/" + GetName(asset) + ".tex";
+
+  if (parameters.m_cache)
+  {
+    try
+    {
+      TexturePayload payload = TexturePayload::Read(fileName);
+
+      if (payload.m_format == parameters.m_format &&
+          payload.m_levels.size() == levels &&
+          payload.m_sourceHash == TexturePayload::Hash(pixels.constBits(), width, height))
+      {
+        return payload;
+      }
+    }
+    catch (ReadFileException const &)
+    {
+      // The cache is built at the first start.
+    }
+  }
+
+  TexturePayload payload = TexturePayload::Build(pixels.constBits(), width, height,
+                                                 parameters.m_mipmaps, parameters.m_format);
+
+  if (parameters.m_cache)
+  {
+    try
+    {
+      QDir().mkpath(QString::fromStdString(Globals::TextureCacheDirectory));
+      payload.Write(fileName);
+    }
+    catch (WriteFileException const & ex)
+    {
+      qDebug() << ex.what();
+    }
+  }
+
+  return payload;
+}
+
+QOpenGLTexture * TextureManager::Upload(TexturePayload const & payload)
+{
+  TextureLevel const & base = payload.m_levels.front();
+  int const levels = static_cast<int>(payload.m_levels.size());
+
+  QOpenGLTexture * texture = new QOpenGLTexture(QOpenGLTexture::Target2D);
+  texture->setSize(base.m_width, base.m_height);
+  texture->setMipLevels(levels);
+
+  if (payload.m_format == TextureFormat::DXT5)
+  {
+    texture->setFormat(QOpenGLTexture::RGBA_DXT5);
+    texture->allocateStorage();
+  }
+  else
+  {
+    texture->setFormat(QOpenGLTexture::RGBA8_UNorm);
+    texture->allocateStorage(QOpenGLTexture::RGBA, QOpenGLTexture::UInt8);
+  }
+
+  for (int i = 0; i < levels; ++i)
+  {
+    TextureLevel const & level = payload.m_levels[i];
+
+    if (payload.m_format == TextureFormat::DXT5)
+    {
+      texture->setCompressedData(i, static_cast<int>(level.m_data.size()), level.m_data.data());
+    }
+    else
+    {
+      texture->setData(i, QOpenGLTexture::RGBA, QOpenGLTexture::UInt8, level.m_data.data());
+    }
+  }
+
+  // Sprites are drawn smaller than their images, the mip levels remove the aliasing.
+  texture->setMinMagFilters(levels > 1 ? QOpenGLTexture::LinearMipMapLinear : QOpenGLTexture::Linear,
+                            QOpenGLTexture::Linear);
+  texture->setWrapMode(QOpenGLTexture::ClampToEdge);
+
+  return texture;
+}
+
+bool TextureManager::CheckLeaks()
+{
+  bool clean = true;
+
+  for (size_t i = 0; i < kAssetCount; ++i)
+  {
+    if (g_stats[i].m_count > 0)
+    {
+      qDebug() << "Leaked textures of" << kNames[i] << ":"
+               << g_stats[i].m_count << "," << g_stats[i].m_bytes << "bytes.";
+      clean = false;
+    }
+  }
+
+  return clean;
+}
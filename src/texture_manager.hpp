@@ -0,0 +1,98 @@
+#pragma once
+
+#include <QImage>
+#include <QOpenGLTexture>
+
+#include <array>
+#include <memory>
+
+#include "render_list.hpp"
+#include "texture_parameters.hpp"
+
+///
+/// Live textures of one asset.
+///
+struct TextureStats
+{
+  size_t m_count = 0;
+  size_t m_bytes = 0;
+};
+
+///
+/// Owner of the textures of one GL context.
+///
+/// Every asset has one texture, which is shared by all its draws.
+/// Textures of all managers are counted by assets until their last
+/// owner releases them, so textures which outlive their widget are seen.
+/// A texture which doesn't fit the budget is uploaded at a lower resolution.
+///
+/// Mip levels are filtered and compressed once per asset instead of
+/// by the driver, the result may be cached on the disk.
+///
+/// It is used on the GL thread only.
+///
+class TextureManager
+{
+public:
+  /// The budget is in bytes, 0 means no limit.
+  explicit TextureManager(size_t budget = 0);
+
+  TextureManager(TextureManager const &) = delete;
+  TextureManager & operator=(TextureManager const &) = delete;
+
+  ///
+  /// The texture of the asset. It is uploaded at the first call,
+  /// the context of the manager must be current.
+  ///
+  std::shared_ptr<QOpenGLTexture> Acquire(RenderAsset asset,
+                                          QImage const & image,
+                                          TextureParameters const & parameters = TextureParameters());
+
+  /// The texture of the asset, nullptr if it isn't uploaded.
+  std::shared_ptr<QOpenGLTexture> const & Get(RenderAsset asset) const;
+
+  ///
+  /// Release the textures of the manager. The context must be current.
+  ///
+  void Clear();
+
+  size_t GetBudget() const;
+  void SetBudget(size_t budget);
+
+  /// Live textures of all managers.
+  static TextureStats GetStats(RenderAsset asset);
+  static TextureStats GetTotal();
+
+  static char const * GetName(RenderAsset asset);
+
+  ///
+  /// GPU memory of a texture with its mip levels.
+  ///
+  static size_t EstimateBytes(int width, int height, TextureParameters const & parameters);
+
+  ///
+  /// Whether the current context can sample the format.
+  ///
+  static bool IsSupported(TextureFormat format);
+
+  ///
+  /// Report textures which are still alive, for example
+  /// after their widget is deleted. It returns true if there are none.
+  ///
+  static bool CheckLeaks();
+
+private:
+  ///
+  /// The payload from the cache if it's built from the same image,
+  /// otherwise a new one.
+  ///
+  static TexturePayload LoadPayload(RenderAsset asset,
+                                    QImage const & image,
+                                    TextureParameters const & parameters);
+
+  static QOpenGLTexture * Upload(TexturePayload const & payload);
+
+  size_t m_budget;
+
+  std::array<std::shared_ptr<QOpenGLTexture>, static_cast<size_t>(RenderAsset::Count)> m_textures;
+};
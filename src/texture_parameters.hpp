@@ -0,0 +1,18 @@
+#pragma once
+
+#include "texture_payload.hpp"
+
+///
+/// Upload of one texture asset.
+///
+struct TextureParameters
+{
+  /// Mip levels are generated once at the load.
+  bool m_mipmaps = true;
+
+  /// A compressed format falls back to RGBA8 if the context doesn't support it.
+  TextureFormat m_format = TextureFormat::RGBA8;
+
+  /// The converted payload is stored to the texture cache and used at the next start.
+  bool m_cache = false;
+};
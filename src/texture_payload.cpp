@@ -0,0 +1,448 @@
+#include "texture_payload.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "except.hpp"
+#include "snapshot.hpp"
+#include "util.hpp"
+
+namespace
+{
+
+char constexpr kMagic[] = { 'S', 'I', 'T', 'X' };
+uint8_t constexpr kVersion = 1;
+
+template<typename T>
+void Append(std::string & out, T const & value)
+{
+  out.append(reinterpret_cast<char const *>(&value), sizeof(T));
+}
+
+class Reader
+{
+public:
+  Reader(std::string const & data, std::string const & fileName)
+    : m_data(data), m_fileName(fileName)
+  {}
+
+  template<typename T>
+  T Read()
+  {
+    T value;
+    std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  char const * Take(size_t size)
+  {
+    if (size > m_data.size() - m_position)
+    {
+      throw ReadFileException(m_fileName);
+    }
+
+    char const * data = m_data.data() + m_position;
+    m_position += size;
+    return data;
+  }
+
+private:
+  std::string const & m_data;
+  std::string const & m_fileName;
+  size_t m_position = 0;
+};
+
+TextureLevel Downsample(TextureLevel const & source)
+{
+  TextureLevel level;
+  level.m_width = std::max(source.m_width / 2, 1);
+  level.m_height = std::max(source.m_height / 2, 1);
+  level.m_data.resize(static_cast<size_t>(level.m_width) * level.m_height * 4);
+
+  for (int y = 0; y < level.m_height; ++y)
+  {
+    for (int x = 0; x < level.m_width; ++x)
+    {
+      unsigned color[3] = { 0, 0, 0 };
+      unsigned alpha = 0;
+
+      // The last row or column of an odd size is taken twice.
+      for (int i = 0; i < 4; ++i)
+      {
+        int const sx = std::min(2 * x + i % 2, source.m_width - 1);
+        int const sy = std::min(2 * y + i / 2, source.m_height - 1);
+        unsigned char const * pixel = &source.m_data[(static_cast<size_t>(sy) * source.m_width + sx) * 4];
+
+        alpha += pixel[3];
+        for (int c = 0; c < 3; ++c)
+        {
+          color[c] += pixel[c] * pixel[3];
+        }
+      }
+
+      unsigned char * pixel = &level.m_data[(static_cast<size_t>(y) * level.m_width + x) * 4];
+      pixel[3] = static_cast<unsigned char>((alpha + 2) / 4);
+      for (int c = 0; c < 3; ++c)
+      {
+        pixel[c] = alpha > 0 ? static_cast<unsigned char>((color[c] + alpha / 2) / alpha) : 0;
+      }
+    }
+  }
+
+  return level;
+}
+
+uint16_t To565(int const (&color)[3])
+{
+  return static_cast<uint16_t>(((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3));
+}
+
+void From565(uint16_t value, int (&color)[3])
+{
+  int const r = (value >> 11) & 31;
+  int const g = (value >> 5) & 63;
+  int const b = value & 31;
+
+  color[0] = (r << 3) | (r >> 2);
+  color[1] = (g << 2) | (g >> 4);
+  color[2] = (b << 3) | (b >> 2);
+}
+
+std::vector<unsigned char> Compress(TextureLevel const & level)
+{
+  int const blocksX = (level.m_width + 3) / 4;
+  int const blocksY = (level.m_height + 3) / 4;
+
+  std::vector<unsigned char> out(static_cast<size_t>(blocksX) * blocksY * 16);
+  unsigned char block[64];
+
+  for (int by = 0; by < blocksY; ++by)
+  {
+    for (int bx = 0; bx < blocksX; ++bx)
+    {
+      // Blocks over the edge repeat the last pixels.
+      for (int i = 0; i < 16; ++i)
+      {
+        int const sx = std::min(bx * 4 + i % 4, level.m_width - 1);
+        int const sy = std::min(by * 4 + i / 4, level.m_height - 1);
+        std::memcpy(block + i * 4, &level.m_data[(static_cast<size_t>(sy) * level.m_width + sx) * 4], 4);
+      }
+
+      TexturePayload::EncodeDXT5(block, &out[(static_cast<size_t>(by) * blocksX + bx) * 16]);
+    }
+  }
+
+  return out;
+}
+
+} // namespace
+
+TexturePayload TexturePayload::Build(unsigned char const * pixels, int width, int height,
+                                     bool mipmaps, TextureFormat format)
+{
+  TexturePayload payload;
+  payload.m_format = format;
+  payload.m_sourceHash = Hash(pixels, width, height);
+
+  TextureLevel level;
+  level.m_width = width;
+  level.m_height = height;
+  level.m_data.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
+
+  int const count = mipmaps ? GetMipLevels(width, height) : 1;
+
+  // Levels are filtered from the uncompressed previous level.
+  for (int i = 0; i < count; ++i)
+  {
+    TextureLevel next;
+    if (i + 1 < count)
+    {
+      next = Downsample(level);
+    }
+
+    if (format == TextureFormat::DXT5)
+    {
+      level.m_data = Compress(level);
+    }
+
+    payload.m_levels.push_back(std::move(level));
+    level = std::move(next);
+  }
+
+  return payload;
+}
+
+void TexturePayload::Write(std::string const & fileName) const
+{
+  std::string out(kMagic, sizeof(kMagic));
+  Append(out, kVersion);
+  Append(out, static_cast<uint8_t>(m_format));
+  Append(out, m_sourceHash);
+  Append(out, static_cast<uint32_t>(m_levels.size()));
+
+  for (auto const & level : m_levels)
+  {
+    Append(out, static_cast<uint32_t>(level.m_width));
+    Append(out, static_cast<uint32_t>(level.m_height));
+    out.append(reinterpret_cast<char const *>(level.m_data.data()), level.m_data.size());
+  }
+
+  // A crash or another game never leaves a half written payload.
+  Util::WriteFileAtomic(fileName, out);
+}
+
+TexturePayload TexturePayload::Read(std::string const & fileName)
+{
+  std::ifstream ifs(fileName, std::ifstream::binary);
+
+  if (!ifs.is_open())
+  {
+    throw ReadFileException(fileName);
+  }
+
+  std::string const data((std::istreambuf_iterator<char>(ifs)),
+                         std::istreambuf_iterator<char>());
+
+  Reader reader(data, fileName);
+
+  if (std::memcmp(reader.Take(sizeof(kMagic)), kMagic, sizeof(kMagic)) != 0 ||
+      reader.Read<uint8_t>() != kVersion)
+  {
+    throw ReadFileException(fileName);
+  }
+
+  uint8_t const format = reader.Read<uint8_t>();
+  if (format > static_cast<uint8_t>(TextureFormat::DXT5))
+  {
+    throw ReadFileException(fileName);
+  }
+
+  TexturePayload payload;
+  payload.m_format = static_cast<TextureFormat>(format);
+  payload.m_sourceHash = reader.Read<uint64_t>();
+
+  uint32_t const count = reader.Read<uint32_t>();
+
+  // Every level takes at least its header.
+  if (count > data.size() / 8)
+  {
+    throw ReadFileException(fileName);
+  }
+
+  payload.m_levels.resize(count);
+
+  for (auto & level : payload.m_levels)
+  {
+    uint32_t const width = reader.Read<uint32_t>();
+    uint32_t const height = reader.Read<uint32_t>();
+
+    if (width == 0 || height == 0 || width > data.size() || height > data.size())
+    {
+      throw ReadFileException(fileName);
+    }
+
+    level.m_width = static_cast<int>(width);
+    level.m_height = static_cast<int>(height);
+
+    size_t const size = GetLevelSize(level.m_width, level.m_height, payload.m_format);
+    unsigned char const * bytes = reinterpret_cast<unsigned char const *>(reader.Take(size));
+    level.m_data.assign(bytes, bytes + size);
+  }
+
+  return payload;
+}
+
+uint64_t TexturePayload::Hash(unsigned char const * pixels, int width, int height)
+{
+  size_t const size = static_cast<size_t>(width) * height * 4;
+  uint64_t hash = Snapshot::Combine(static_cast<uint64_t>(width), static_cast<uint64_t>(height));
+
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+  {
+    uint64_t word;
+    std::memcpy(&word, pixels + i, sizeof(uint64_t));
+    hash = Snapshot::Combine(hash, word);
+  }
+
+  for (; i < size; ++i)
+  {
+    hash = Snapshot::Combine(hash, pixels[i]);
+  }
+
+  return hash;
+}
+
+void TexturePayload::EncodeDXT5(unsigned char const * block, unsigned char * out)
+{
+  // Alpha: the end points and six values between them.
+  int alphaMin = 255;
+  int alphaMax = 0;
+
+  for (int i = 0; i < 16; ++i)
+  {
+    alphaMin = std::min<int>(alphaMin, block[i * 4 + 3]);
+    alphaMax = std::max<int>(alphaMax, block[i * 4 + 3]);
+  }
+
+  int alphas[8] = { alphaMax, alphaMin };
+  for (int i = 1; i < 7; ++i)
+  {
+    alphas[i + 1] = ((7 - i) * alphaMax + i * alphaMin + 3) / 7;
+  }
+
+  uint64_t alphaBits = 0;
+  for (int i = 0; i < 16; ++i)
+  {
+    int best = 0;
+    for (int j = 1; j < 8; ++j)
+    {
+      if (std::abs(alphas[j] - block[i * 4 + 3]) < std::abs(alphas[best] - block[i * 4 + 3]))
+      {
+        best = j;
+      }
+    }
+    alphaBits |= static_cast<uint64_t>(best) << (3 * i);
+  }
+
+  out[0] = static_cast<unsigned char>(alphaMax);
+  out[1] = static_cast<unsigned char>(alphaMin);
+  for (int i = 0; i < 6; ++i)
+  {
+    out[2 + i] = static_cast<unsigned char>(alphaBits >> (8 * i));
+  }
+
+  // Color: two corners of the bounding box of the visible pixels and two values between them.
+  int low[3] = { 255, 255, 255 };
+  int high[3] = { 0, 0, 0 };
+  bool visible[16];
+
+  for (int pass = 0; pass < 2 && high[0] < low[0]; ++pass)
+  {
+    for (int i = 0; i < 16; ++i)
+    {
+      visible[i] = pass == 1 || block[i * 4 + 3] > 0;
+
+      if (visible[i])
+      {
+        for (int c = 0; c < 3; ++c)
+        {
+          low[c] = std::min<int>(low[c], block[i * 4 + c]);
+          high[c] = std::max<int>(high[c], block[i * 4 + c]);
+        }
+      }
+    }
+  }
+
+  // The diagonal follows the widest channel, a channel which falls while it grows is swapped.
+  int widest = 0;
+  for (int c = 1; c < 3; ++c)
+  {
+    if (high[c] - low[c] > high[widest] - low[widest])
+    {
+      widest = c;
+    }
+  }
+
+  for (int c = 0; c < 3; ++c)
+  {
+    int covariance = 0;
+    for (int i = 0; i < 16; ++i)
+    {
+      if (visible[i])
+      {
+        covariance += (block[i * 4 + widest] - (low[widest] + high[widest]) / 2) *
+                      (block[i * 4 + c] - (low[c] + high[c]) / 2);
+      }
+    }
+
+    if (covariance < 0)
+    {
+      std::swap(low[c], high[c]);
+    }
+  }
+
+  uint16_t const color0 = To565(high);
+  uint16_t const color1 = To565(low);
+
+  int colors[4][3];
+  From565(color0, colors[0]);
+  From565(color1, colors[1]);
+  for (int c = 0; c < 3; ++c)
+  {
+    colors[2][c] = (2 * colors[0][c] + colors[1][c]) / 3;
+    colors[3][c] = (colors[0][c] + 2 * colors[1][c]) / 3;
+  }
+
+  uint32_t colorBits = 0;
+  for (int i = 0; i < 16; ++i)
+  {
+    int best = 0;
+    int bestDistance = 0;
+
+    for (int j = 0; j < 4; ++j)
+    {
+      int distance = 0;
+      for (int c = 0; c < 3; ++c)
+      {
+        int const d = colors[j][c] - block[i * 4 + c];
+        distance += d * d;
+      }
+
+      if (j == 0 || distance < bestDistance)
+      {
+        best = j;
+        bestDistance = distance;
+      }
+    }
+    colorBits |= static_cast<uint32_t>(best) << (2 * i);
+  }
+
+  out[8] = static_cast<unsigned char>(color0);
+  out[9] = static_cast<unsigned char>(color0 >> 8);
+  out[10] = static_cast<unsigned char>(color1);
+  out[11] = static_cast<unsigned char>(color1 >> 8);
+  for (int i = 0; i < 4; ++i)
+  {
+    out[12 + i] = static_cast<unsigned char>(colorBits >> (8 * i));
+  }
+}
+
+size_t TexturePayload::GetLevelSize(int width, int height, TextureFormat format)
+{
+  if (format == TextureFormat::DXT5)
+  {
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * 16;
+  }
+
+  return static_cast<size_t>(width) * height * 4;
+}
+
+int TexturePayload::GetMipLevels(int width, int height)
+{
+  int levels = 1;
+
+  while (width > 1 || height > 1)
+  {
+    width = std::max(width / 2, 1);
+    height = std::max(height / 2, 1);
+    ++levels;
+  }
+
+  return levels;
+}
+
+size_t TexturePayload::GetBytes() const
+{
+  size_t bytes = 0;
+
+  for (auto const & level : m_levels)
+  {
+    bytes += level.m_data.size();
+  }
+
+  return bytes;
+}
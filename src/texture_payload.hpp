@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///
+/// Formats of the texture upload.
+///
+enum class TextureFormat : uint8_t
+{
+  RGBA8,
+  // S3TC with the interpolated alpha, 16 bytes per 4x4 block.
+  DXT5
+};
+
+struct TextureLevel
+{
+  int m_width = 0;
+  int m_height = 0;
+  std::vector<unsigned char> m_data;
+};
+
+///
+/// Pixels of a texture with its mip levels in the upload format.
+///
+/// It is built once per asset from the source image. The payload can be
+/// stored to a file, so the next start uploads it without any conversion.
+///
+struct TexturePayload
+{
+  ///
+  /// Build the payload from RGBA8 pixels. Rows follow each other without padding.
+  ///
+  /// Mip levels are filtered by 2x2 boxes down to 1x1. Colors are weighted
+  /// by alpha, so transparent pixels don't darken the edges of sprites.
+  ///
+  static TexturePayload Build(unsigned char const * pixels, int width, int height,
+                              bool mipmaps, TextureFormat format);
+
+  ///
+  /// The file is a cache of the local machine, it keeps the byte order.
+  /// It is replaced atomically.
+  ///
+  /// Exception: WriteFileException.
+  ///
+  void Write(std::string const & fileName) const;
+
+  ///
+  /// Exception: ReadFileException.
+  ///
+  static TexturePayload Read(std::string const & fileName);
+
+  /// Hash of the source image. A cached payload is valid if it matches.
+  static uint64_t Hash(unsigned char const * pixels, int width, int height);
+
+  ///
+  /// Compress a 4x4 block of RGBA8 pixels, rows go one by one.
+  ///
+  static void EncodeDXT5(unsigned char const * block, unsigned char * out);
+
+  /// Bytes of one level.
+  static size_t GetLevelSize(int width, int height, TextureFormat format);
+
+  /// Number of levels down to 1x1.
+  static int GetMipLevels(int width, int height);
+
+  /// Bytes of all levels.
+  size_t GetBytes() const;
+
+  TextureFormat m_format = TextureFormat::RGBA8;
+  uint64_t m_sourceHash = 0;
+  std::vector<TextureLevel> m_levels;
+};
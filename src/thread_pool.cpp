@@ -0,0 +1,147 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t threads)
+{
+  if (threads == 0)
+  {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  for (size_t i = 1; i < threads; ++i)
+  {
+    m_workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopping = true;
+  }
+
+  m_startCondition.notify_all();
+
+  for (auto & worker : m_workers)
+  {
+    worker.join();
+  }
+}
+
+size_t ThreadPool::GetSize() const
+{
+  return m_workers.size() + 1;
+}
+
+void ThreadPool::ParallelFor(size_t count, TTask const & task)
+{
+  if (count == 0)
+  {
+    return;
+  }
+
+  if (m_workers.empty())
+  {
+    task(0, count);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_task = &task;
+    m_count = count;
+    m_pending = m_workers.size();
+    m_exception = nullptr;
+    m_generation++;
+  }
+
+  m_startCondition.notify_all();
+
+  // The calling thread takes the first range.
+  std::exception_ptr exception;
+
+  try
+  {
+    RunRange(0);
+  }
+  catch (...)
+  {
+    exception = std::current_exception();
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_finishCondition.wait(lock, [this]() { return m_pending == 0; });
+
+  m_task = nullptr;
+
+  if (exception == nullptr)
+  {
+    exception = m_exception;
+  }
+
+  if (exception != nullptr)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+void ThreadPool::WorkerLoop(size_t index)
+{
+  uint64_t generation = 0;
+
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_startCondition.wait(lock, [this, generation]()
+      {
+        return m_isStopping || m_generation != generation;
+      });
+
+      if (m_isStopping)
+      {
+        return;
+      }
+
+      generation = m_generation;
+    }
+
+    std::exception_ptr exception;
+
+    try
+    {
+      RunRange(index);
+    }
+    catch (...)
+    {
+      exception = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      if (exception != nullptr && m_exception == nullptr)
+      {
+        m_exception = exception;
+      }
+
+      m_pending--;
+    }
+
+    m_finishCondition.notify_one();
+  }
+}
+
+void ThreadPool::RunRange(size_t index)
+{
+  size_t const threads = GetSize();
+  size_t const begin = m_count * index / threads;
+  size_t const end = m_count * (index + 1) / threads;
+
+  if (begin < end)
+  {
+    (*m_task)(begin, end);
+  }
+}
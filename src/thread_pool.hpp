@@ -0,0 +1,55 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+///
+/// Fixed set of threads which process ranges of a loop.
+///
+class ThreadPool
+{
+public:
+  using TTask = std::function<void(size_t begin, size_t end)>;
+
+  ///
+  /// Zero threads means one thread per hardware core.
+  /// The calling thread is counted, so ThreadPool(1) doesn't start any thread.
+  ///
+  explicit ThreadPool(size_t threads = 0);
+  ~ThreadPool();
+
+  ThreadPool(ThreadPool const &) = delete;
+  ThreadPool & operator=(ThreadPool const &) = delete;
+
+  size_t GetSize() const;
+
+  ///
+  /// Split [0, count) into one contiguous range per thread
+  /// and wait until all ranges are processed.
+  ///
+  /// An exception of the task is rethrown in the calling thread.
+  ///
+  void ParallelFor(size_t count, TTask const & task);
+
+private:
+  void WorkerLoop(size_t index);
+  void RunRange(size_t index);
+
+  std::vector<std::thread> m_workers;
+
+  std::mutex m_mutex;
+  std::condition_variable m_startCondition;
+  std::condition_variable m_finishCondition;
+
+  // The current loop, it is guarded by m_mutex.
+  TTask const * m_task = nullptr;
+  size_t m_count = 0;
+  uint64_t m_generation = 0;
+  size_t m_pending = 0;
+  std::exception_ptr m_exception;
+  bool m_isStopping = false;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+///
+/// Hands the newest value from one producer thread to one consumer thread.
+///
+/// The producer fills the write buffer and publishes it, the consumer
+/// takes the newest published buffer. Neither side waits for the other
+/// and a buffer is never used by both threads at the same time.
+///
+template<typename T>
+class TripleBuffer
+{
+public:
+  TripleBuffer() = default;
+
+  TripleBuffer(TripleBuffer const &) = delete;
+  TripleBuffer & operator=(TripleBuffer const &) = delete;
+
+  ///
+  /// Producer side. The buffer keeps its previous content,
+  /// so its memory can be reused.
+  ///
+  T & GetWriteBuffer()
+  {
+    return m_buffers[m_write];
+  }
+
+  ///
+  /// Producer side. Make the write buffer the newest one.
+  ///
+  void Publish()
+  {
+    uint8_t const previous = m_middle.exchange(m_write | kNewFlag, std::memory_order_acq_rel);
+    m_write = previous & kIndexMask;
+  }
+
+  ///
+  /// Consumer side. Switch to the newest published buffer if there is one.
+  ///
+  /// Return true if the buffer is new.
+  ///
+  bool Update()
+  {
+    if ((m_middle.load(std::memory_order_relaxed) & kNewFlag) == 0)
+    {
+      return false;
+    }
+
+    uint8_t const previous = m_middle.exchange(m_read, std::memory_order_acq_rel);
+    m_read = previous & kIndexMask;
+    return true;
+  }
+
+  ///
+  /// Consumer side. The buffer taken by the last Update().
+  ///
+  T const & GetReadBuffer() const
+  {
+    return m_buffers[m_read];
+  }
+
+private:
+  static uint8_t constexpr kIndexMask = 0x3;
+  static uint8_t constexpr kNewFlag = 0x4;
+
+  std::array<T, 3> m_buffers;
+
+  // Only the producer uses m_write, only the consumer uses m_read.
+  uint8_t m_write = 0;
+  uint8_t m_read = 1;
+
+  // The buffer between them and the flag of unread data.
+  std::atomic<uint8_t> m_middle { 2 };
+};
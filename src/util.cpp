@@ -1,8 +1,17 @@
 #include "util.hpp"
 
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 #include "json/assertions.h"
 #include "json/value.h"
 #include "json/writer.h"
@@ -11,6 +20,60 @@
 
 #include "except.hpp"
 
+namespace
+{
+
+bool WriteFile(std::string const & file_name, std::string const & data)
+{
+  std::FILE * file = std::fopen(file_name.c_str(), "wb");
+
+  if (file == nullptr)
+  {
+    return false;
+  }
+
+#ifdef _WIN32
+  bool const isWritten = std::fwrite(data.data(), 1, data.size(), file) == data.size() &&
+                         std::fflush(file) == 0 &&
+                         _commit(_fileno(file)) == 0;
+#else
+  bool const isWritten = std::fwrite(data.data(), 1, data.size(), file) == data.size() &&
+                         std::fflush(file) == 0 &&
+                         fsync(fileno(file)) == 0;
+#endif
+
+  return std::fclose(file) == 0 && isWritten;
+}
+
+bool ReplaceFile(std::string const & from, std::string const & to)
+{
+#ifdef _WIN32
+  return MoveFileExA(from.c_str(), to.c_str(),
+                     MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+  if (std::rename(from.c_str(), to.c_str()) != 0)
+  {
+    return false;
+  }
+
+  // The new directory entry must reach the disk too.
+  size_t const separator = to.find_last_of('/');
+  std::string const directory = separator == std::string::npos ? "." : to.substr(0, separator + 1);
+
+  int const fd = open(directory.c_str(), O_RDONLY);
+
+  if (fd >= 0)
+  {
+    fsync(fd);
+    close(fd);
+  }
+
+  return true;
+#endif
+}
+
+} // namespace
+
 
 void Util::WriteJson(std::string const &  file_name,
                      Json::Value const & out)
@@ -50,3 +113,39 @@ Json::Value Util::ReadJson(std::string const & file_name)
 
   return root;
 }
+
+void Util::WriteJsonAtomic(std::string const & file_name,
+                           Json::Value const & out)
+{
+  Json::StyledWriter styledWriter;
+
+  WriteFileAtomic(file_name, styledWriter.write(out));
+}
+
+void Util::WriteFileAtomic(std::string const & file_name,
+                           std::string const & data)
+{
+  std::string const temp_name = file_name + ".tmp";
+
+  if (!WriteFile(temp_name, data) ||
+      !ReplaceFile(temp_name, file_name))
+  {
+    std::remove(temp_name.c_str());
+
+    throw WriteFileException(file_name);
+  }
+}
+
+void Util::MergeJson(Json::Value & base, Json::Value const & overlay)
+{
+  if (!base.isObject() || !overlay.isObject())
+  {
+    base = overlay;
+    return;
+  }
+
+  for (auto const & name : overlay.getMemberNames())
+  {
+    MergeJson(base[name], overlay[name]);
+  }
+}
@@ -16,4 +16,29 @@ public:
                         Json::Value const & out);
 
   static Json::Value ReadJson(std::string const & file_name);
+
+  ///
+  /// Replace a file, so a crash leaves either the old or the new content.
+  ///
+  /// The data goes to a temporary file, which is flushed to the disk
+  /// and renamed over the target.
+  ///
+  /// Exception: WriteFileException.
+  ///
+  static void WriteJsonAtomic(std::string const & file_name,
+                              Json::Value const & out);
+
+  ///
+  /// Replace a file by the bytes in the same way.
+  ///
+  /// Exception: WriteFileException.
+  ///
+  static void WriteFileAtomic(std::string const & file_name,
+                              std::string const & data);
+
+  ///
+  /// Copy members of the overlay over the base. Objects are merged
+  /// member by member, other values are replaced.
+  ///
+  static void MergeJson(Json::Value & base, Json::Value const & overlay);
 };
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <sys/types.h>
+#include "game_entity.hpp"
+
+/// Layout of the aliens of a wave.
+enum class WavePattern : uint8_t
+{
+  // Columns x rows.
+  Grid,
+  // Every next row is shorter by one alien from both sides.
+  Wedge
+};
+
+/// How an alien comes to its place in the formation.
+enum class WavePath : uint8_t
+{
+  // It appears in its place.
+  None,
+  // It flies from the entry point along a line.
+  Straight,
+  // It flies from the entry point along an arc, vertically first.
+  Swoop
+};
+
+///
+/// One wave of a level. Positions are offsets in the alien formation,
+/// so a late wave lines up with the aliens which are already there.
+///
+struct WaveParameters
+{
+  /// Start of the wave in seconds from the start of the level.
+  float m_time = 0.0f;
+  /// Seconds between two aliens of the wave.
+  float m_interval = 0.0f;
+
+  WavePattern m_pattern = WavePattern::Grid;
+  size_t m_columns = 0;
+  size_t m_rows = 1;
+  float m_x = 0.0f;
+  float m_y = 0.0f;
+  float m_spacingX = 0.0f;
+  float m_spacingY = 0.0f;
+
+  /// Parameters of the aliens of the wave.
+  int m_health = 0;
+  uint m_frequency = 0;
+  TSize m_size = std::make_pair(0, 0);
+
+  WavePath m_path = WavePath::None;
+  /// Flight time of the entry path in seconds.
+  float m_pathTime = 0.0f;
+  /// Entry point relative to the place of the alien.
+  float m_entryX = 0.0f;
+  float m_entryY = 0.0f;
+};
@@ -0,0 +1,195 @@
+#include "wave_script.hpp"
+
+#include <algorithm>
+
+#include "snapshot.hpp"
+
+void WaveScript::Compile(GameParameters const & parameters, QSize const & fieldSize)
+{
+  m_waves = parameters.m_waves;
+  m_fieldSize = fieldSize;
+  m_events.clear();
+
+  m_time = 0.0f;
+  m_next = 0;
+  m_entryEnd = 0.0f;
+  m_scaleX = m_scaleY = 1.0f;
+
+  AlienParameters const & aliens = parameters.m_alienParameters;
+
+  // One grid of the level parameters.
+  if (m_waves.empty() && aliens.m_number > 0)
+  {
+    WaveParameters wave;
+    wave.m_columns = aliens.m_number;
+    wave.m_rows = aliens.m_rowNumber;
+    wave.m_y = 600.0f;
+    wave.m_spacingX = fieldSize.width() / aliens.m_number;
+    wave.m_spacingY = aliens.m_size.second;
+    wave.m_health = aliens.m_health;
+    wave.m_frequency = aliens.m_frequency;
+    wave.m_size = aliens.m_size;
+
+    m_waves.push_back(wave);
+  }
+
+  for (auto const & wave : m_waves)
+  {
+    AddWave(wave);
+  }
+
+  // Waves may overlap, events of the same time keep the wave order.
+  std::stable_sort(m_events.begin(), m_events.end(), [](SpawnEvent const & a, SpawnEvent const & b)
+  {
+    return a.m_time < b.m_time;
+  });
+
+  m_isCompiled = true;
+}
+
+void WaveScript::AddWave(WaveParameters const & wave)
+{
+  SpawnEvent event;
+  event.m_wave = static_cast<uint32_t>(&wave - m_waves.data());
+
+  size_t count = 0;
+
+  for (size_t j = 0; j < wave.m_rows; ++j)
+  {
+    size_t first = 0;
+    size_t last = wave.m_columns;
+
+    if (wave.m_pattern == WavePattern::Wedge)
+    {
+      first = j;
+      last = wave.m_columns > j ? wave.m_columns - j : 0;
+    }
+
+    for (size_t i = first; i < last; ++i)
+    {
+      event.m_time = wave.m_time + count * wave.m_interval;
+      event.m_place = QVector2D(wave.m_x + i * wave.m_spacingX,
+                                wave.m_y + j * wave.m_spacingY);
+
+      m_events.push_back(event);
+      ++count;
+    }
+  }
+}
+
+void WaveScript::Advance(float elapsedSeconds)
+{
+  m_time += elapsedSeconds;
+}
+
+bool WaveScript::Next(SpawnEvent & event)
+{
+  if (m_next == m_events.size() || m_events[m_next].m_time > m_time)
+  {
+    return false;
+  }
+
+  event = m_events[m_next++];
+  event.m_place = QVector2D(event.m_place.x() * m_scaleX, event.m_place.y() * m_scaleY);
+
+  WaveParameters const & wave = m_waves[event.m_wave];
+
+  if (wave.m_path != WavePath::None)
+  {
+    m_entryEnd = std::max(m_entryEnd, m_time + wave.m_pathTime);
+  }
+
+  return true;
+}
+
+void WaveScript::GetEntryPath(SpawnEvent const & event,
+                              QVector2D & start,
+                              QVector2D & control) const
+{
+  WaveParameters const & wave = m_waves[event.m_wave];
+
+  start = event.m_place + QVector2D(wave.m_entryX * m_scaleX, wave.m_entryY * m_scaleY);
+
+  switch (wave.m_path)
+  {
+    case WavePath::Swoop:
+      control = QVector2D(start.x(), event.m_place.y());
+      break;
+    case WavePath::Straight:
+    case WavePath::None:
+    default:
+      control = (start + event.m_place) * 0.5f;
+      break;
+  }
+}
+
+WaveParameters const & WaveScript::GetWave(uint32_t index) const
+{
+  return m_waves[index];
+}
+
+bool WaveScript::IsFinished() const
+{
+  return m_next == m_events.size();
+}
+
+bool WaveScript::IsEntering() const
+{
+  return m_time < m_entryEnd;
+}
+
+void WaveScript::Finish()
+{
+  m_next = m_events.size();
+}
+
+void WaveScript::Scale(float x, float y)
+{
+  m_scaleX *= x;
+  m_scaleY *= y;
+}
+
+std::vector<SpawnEvent> const & WaveScript::GetEvents() const
+{
+  return m_events;
+}
+
+float WaveScript::GetTime() const
+{
+  return m_time;
+}
+
+void WaveScript::Save(Snapshot & snapshot) const
+{
+  snapshot.Write(m_fieldSize.width());
+  snapshot.Write(m_fieldSize.height());
+  snapshot.Write(m_time);
+  snapshot.Write(static_cast<uint64_t>(m_next));
+  snapshot.Write(m_entryEnd);
+  snapshot.Write(m_scaleX);
+  snapshot.Write(m_scaleY);
+}
+
+void WaveScript::Restore(Snapshot & snapshot, GameParameters const & parameters)
+{
+  int const width = snapshot.Read<int>();
+  QSize const fieldSize(width, snapshot.Read<int>());
+
+  if (!m_isCompiled || fieldSize != m_fieldSize)
+  {
+    Compile(parameters, fieldSize);
+  }
+
+  snapshot.Read(m_time);
+  uint64_t const next = snapshot.Read<uint64_t>();
+  snapshot.Read(m_entryEnd);
+  snapshot.Read(m_scaleX);
+  snapshot.Read(m_scaleY);
+
+  if (next > m_events.size())
+  {
+    throw ReadSnapshotException();
+  }
+
+  m_next = static_cast<size_t>(next);
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QSize>
+#include <QVector2D>
+
+#include <cstdint>
+#include <vector>
+
+#include "game_parameters.hpp"
+
+class Snapshot;
+
+///
+/// Appearance of one alien.
+///
+struct SpawnEvent
+{
+  /// Seconds from the start of the level.
+  float m_time = 0.0f;
+  /// Index of the wave.
+  uint32_t m_wave = 0;
+  /// Place of the alien in the formation.
+  QVector2D m_place;
+};
+
+///
+/// Compiled waves of a level and their interpreter.
+///
+/// Compile() turns the waves into one table of spawn events sorted
+/// by time. The interpreter keeps the level time and the position
+/// in the table. Every step the world takes the events which are due,
+/// no more than the spawn budget, so a large wave is spread
+/// over several steps.
+///
+class WaveScript
+{
+public:
+  WaveScript() = default;
+
+  ///
+  /// The field size is used by the grid of a level without waves.
+  ///
+  void Compile(GameParameters const & parameters, QSize const & fieldSize);
+
+  /// Advance the level time.
+  void Advance(float elapsedSeconds);
+
+  ///
+  /// Take the next event which is due. The place is in the current scale.
+  ///
+  bool Next(SpawnEvent & event);
+
+  ///
+  /// Start and control point of the entry path of an event
+  /// in the current scale.
+  ///
+  void GetEntryPath(SpawnEvent const & event,
+                    QVector2D & start,
+                    QVector2D & control) const;
+
+  WaveParameters const & GetWave(uint32_t index) const;
+
+  /// All events are taken.
+  bool IsFinished() const;
+
+  /// Some aliens may be on their entry paths.
+  bool IsEntering() const;
+
+  /// Drop the events which are left.
+  void Finish();
+
+  ///
+  /// Scale the places of the events which are left, it is used on resize.
+  ///
+  void Scale(float x, float y);
+
+  std::vector<SpawnEvent> const & GetEvents() const;
+  float GetTime() const;
+
+  void Save(Snapshot & snapshot) const;
+
+  ///
+  /// The script is compiled again if it was compiled
+  /// for another field size.
+  ///
+  /// Exception: ReadSnapshotException.
+  ///
+  void Restore(Snapshot & snapshot, GameParameters const & parameters);
+
+private:
+  void AddWave(WaveParameters const & wave);
+
+  std::vector<WaveParameters> m_waves;
+  std::vector<SpawnEvent> m_events;
+  bool m_isCompiled = false;
+  QSize m_fieldSize;
+
+  float m_time = 0.0f;
+  // The next event to take.
+  size_t m_next = 0;
+  // The time when the last entry path ends.
+  float m_entryEnd = 0.0f;
+
+  float m_scaleX = 1.0f;
+  float m_scaleY = 1.0f;
+};
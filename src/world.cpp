@@ -0,0 +1,1315 @@
+#include "world.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#include "constants.hpp"
+#include "culling.hpp"
+#include "collision.hpp"
+#include "memory_tracker.hpp"
+
+namespace
+{
+
+int constexpr kLeftDirection = 0;
+int constexpr kRightDirection = 1;
+int constexpr kUpDirection = 2;
+int constexpr kDownDirection = 3;
+
+/// FNV-1a, look here for more info: http://www.isthe.com/chongo/tech/comp/fnv/
+uint64_t constexpr kHashOffset = 14695981039346656037ULL;
+uint64_t constexpr kHashPrime = 1099511628211ULL;
+
+template<typename T>
+void HashValue(uint64_t & hash, T const & value)
+{
+  unsigned char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+
+  for (auto byte : bytes)
+  {
+    hash = (hash ^ byte) * kHashPrime;
+  }
+}
+
+void HashEntity(uint64_t & hash, GameEntity const & entity)
+{
+  HashValue(hash, entity.GetPosition().x());
+  HashValue(hash, entity.GetPosition().y());
+}
+
+///
+/// Hash of one entity for the sums of the lists. The bits are mixed
+/// by the SplitMix64 finalizer, so the sum of close positions spreads.
+///
+uint64_t MixHash(uint64_t hash)
+{
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+  return hash ^ (hash >> 31);
+}
+
+uint64_t EntityHash(Bullet const & bullet)
+{
+  uint64_t hash = kHashOffset;
+  HashEntity(hash, bullet);
+  return MixHash(hash);
+}
+
+template<typename T>
+uint64_t EntityHash(T const & entity)
+{
+  uint64_t hash = kHashOffset;
+  HashEntity(hash, entity);
+  HashValue(hash, entity.GetHealth());
+  return MixHash(hash);
+}
+
+template<typename T>
+uint64_t SumHashes(std::list<std::shared_ptr<T>> const & list)
+{
+  uint64_t sum = 0;
+
+  for (auto const & entity : list)
+  {
+    sum += EntityHash(*entity);
+  }
+
+  return sum;
+}
+
+/// "SISN" and the format version.
+uint32_t constexpr kSnapshotMagic = 0x4e534953;
+uint32_t constexpr kSnapshotVersion = 4;
+
+template<typename T>
+void SaveList(Snapshot & snapshot, std::list<std::shared_ptr<T>> const & list)
+{
+  snapshot.Write(static_cast<uint32_t>(list.size()));
+
+  for (auto const & entity : list)
+  {
+    entity->Save(snapshot);
+  }
+}
+
+///
+/// Resize the list to the stored size and restore its entities.
+/// New entities are created by the factory.
+///
+template<typename T, typename TFactory>
+void RestoreList(Snapshot & snapshot,
+                 std::list<std::shared_ptr<T>> & list,
+                 TFactory factory)
+{
+  uint32_t const size = snapshot.Read<uint32_t>();
+
+  while (list.size() > size)
+  {
+    list.pop_back();
+  }
+
+  while (list.size() < size)
+  {
+    list.push_back(factory());
+  }
+
+  for (auto & entity : list)
+  {
+    entity->Restore(snapshot);
+  }
+}
+
+/// Bullet lists of the obstacle pass.
+uint32_t constexpr kAlienBulletsGroup = 0;
+uint32_t constexpr kSpaceShipBulletsGroup = 1;
+
+/// Entities of a chunk of a parallel loop.
+size_t constexpr kParallelGrain = 256;
+
+///
+/// Apply the function to every entity of the list.
+/// Long lists are split into chunks which run on the job system.
+///
+template<typename T, typename TFunction>
+void ForEachEntity(JobSystem * jobSystem,
+                   std::list<std::shared_ptr<T>> const & list,
+                   std::vector<T *> & buffer,
+                   TFunction const & function)
+{
+  if (jobSystem == nullptr || list.size() < 2 * kParallelGrain)
+  {
+    for (auto const & entity : list)
+    {
+      function(*entity);
+    }
+    return;
+  }
+
+  buffer.clear();
+
+  for (auto const & entity : list)
+  {
+    buffer.push_back(entity.get());
+  }
+
+  jobSystem->ParallelFor(buffer.size(), kParallelGrain, [&buffer, &function](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      function(*buffer[i]);
+    }
+  });
+}
+
+///
+/// Apply the function to every entity of the list like ForEachEntity()
+/// and return the sum of its results. The sum doesn't depend on the chunks.
+///
+template<typename T, typename TFunction>
+uint64_t SumEachEntity(JobSystem * jobSystem,
+                       std::list<std::shared_ptr<T>> const & list,
+                       std::vector<T *> & buffer,
+                       TFunction const & function)
+{
+  if (jobSystem == nullptr || list.size() < 2 * kParallelGrain)
+  {
+    uint64_t sum = 0;
+
+    for (auto const & entity : list)
+    {
+      sum += function(*entity);
+    }
+    return sum;
+  }
+
+  buffer.clear();
+
+  for (auto const & entity : list)
+  {
+    buffer.push_back(entity.get());
+  }
+
+  std::atomic<uint64_t> sum(0);
+
+  jobSystem->ParallelFor(buffer.size(), kParallelGrain, [&buffer, &function, &sum](size_t begin, size_t end)
+  {
+    uint64_t chunkSum = 0;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+      chunkSum += function(*buffer[i]);
+    }
+
+    sum.fetch_add(chunkSum, std::memory_order_relaxed);
+  });
+
+  return sum.load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+float constexpr World::kFixedTimeStep;
+
+World::World(size_t const & level)
+  : World(GameContext::FromSettings(), level)
+{}
+
+World::World(GameContext const & context, size_t const & level)
+  : m_context(context),
+    m_level(level),
+    m_particles(context.m_parameters.m_mainParameters.m_particleCapacity)
+{
+  m_space = std::make_shared<Space>();
+
+  m_gameState = GameState::RUNINIG;
+}
+
+void World::Initialize()
+{
+  Initialize(m_context.m_parameters.m_mainParameters.m_seed);
+}
+
+void World::Initialize(uint64_t seed)
+{
+  MemoryScope scope(MemoryTag::Space);
+
+  // The level number is mixed in so every level has its own sequence.
+  m_starsRandom.Seed(seed + m_level, static_cast<uint64_t>(RandomStream::Stars));
+  m_aliensRandom.Seed(seed + m_level, static_cast<uint64_t>(RandomStream::Aliens));
+  m_particlesRandom.Seed(seed + m_level, static_cast<uint64_t>(RandomStream::Particles));
+
+  AlienParameters const & aliens = m_context.m_parameters.m_alienParameters;
+
+  // The formation starts at the origin, so local offsets are the initial positions.
+  m_formation = Formation(aliens.m_speed, aliens.m_stepDown);
+
+  // Aliens appear from the first step.
+  m_waves.Compile(m_context.m_parameters, m_context.m_fieldSize);
+
+  AddSpaceShip();
+
+  AddObstacles();
+
+  AddStars();
+
+  RehashEntities();
+}
+
+void World::Reset(uint64_t seed)
+{
+  m_space->Clear();
+  m_random.clear();
+  m_particles.Clear();
+  m_frameArena.Reset();
+  m_spawnBuffer.clear();
+
+  m_directions.fill(false);
+  m_tick = 0;
+  m_historyHash = 0;
+  m_gameState = GameState::RUNINIG;
+  m_score = 0;
+  m_collisionTests = 0;
+
+  Initialize(seed);
+}
+
+void World::Apply(InputCommand const & command)
+{
+  switch (command.m_action)
+  {
+    case InputAction::Left:
+      m_directions[kLeftDirection] = command.m_isPressed;
+      break;
+    case InputAction::Right:
+      m_directions[kRightDirection] = command.m_isPressed;
+      break;
+    case InputAction::Up:
+      m_directions[kUpDirection] = command.m_isPressed;
+      break;
+    case InputAction::Down:
+      m_directions[kDownDirection] = command.m_isPressed;
+      break;
+    case InputAction::Fire:
+      Fire();
+      break;
+    case InputAction::KillAliens:
+      KillAliens();
+      break;
+    case InputAction::Menu:
+      // Exit to menu.
+      m_gameState = GameState::MENU;
+      break;
+    case InputAction::Resize:
+      SetPosition(command.m_width, command.m_height);
+      m_context.m_fieldSize = QSize(command.m_width, command.m_height);
+      break;
+  }
+}
+
+void World::Fire()
+{
+  Bullet const bullet(m_space->GetSpaceShip()->GetPosition(),
+                      m_context.m_parameters.m_bulletParameters.m_damage,
+                      m_context.m_parameters.m_bulletParameters.m_size);
+
+  m_space->SpawnSpaceShipBullet(bullet);
+  m_spaceShipBulletsHash += EntityHash(bullet);
+}
+
+// Cheat code. It kills all enemies.
+void World::KillAliens()
+{
+  std::list<TAlienPtr> & lstAlien = m_space->GetAliens();
+  std::list<TObstaclePtr> & lstObstacles = m_space->GetObstacles();
+
+  if (!lstAlien.empty())
+  {
+    m_score += lstAlien.size() * m_context.m_parameters.m_alienParameters.m_score;
+    m_score += lstObstacles.size() * m_context.m_parameters.m_obstacleParameters.m_score;
+
+    lstAlien.clear();
+    m_aliensHash = 0;
+  }
+
+  // The waves which didn't come yet are gone too.
+  m_waves.Finish();
+}
+
+uint64_t World::Hash() const
+{
+  uint64_t hash = kHashOffset;
+
+  HashValue(hash, m_tick);
+  HashValue(hash, m_score);
+  HashValue(hash, static_cast<int>(m_gameState));
+  HashValue(hash, m_starsRandom.GetState());
+  HashValue(hash, m_aliensRandom.GetState());
+  HashValue(hash, m_particlesRandom.GetState());
+
+  HashEntity(hash, *m_space->GetSpaceShip());
+  HashValue(hash, m_space->GetSpaceShip()->GetHealth());
+
+  HashValue(hash, m_space->GetAliens().size());
+  HashValue(hash, m_aliensHash);
+  HashValue(hash, m_space->GetObstacles().size());
+  HashValue(hash, m_obstaclesHash);
+  HashValue(hash, m_space->GetSpaceShipBullets().size());
+  HashValue(hash, m_spaceShipBulletsHash);
+  HashValue(hash, m_space->GetAlienBullets().size());
+  HashValue(hash, m_alienBulletsHash);
+
+  HashValue(hash, m_particles.GetCount());
+
+  return hash;
+}
+
+void World::RehashEntities()
+{
+  m_aliensHash = SumHashes(m_space->GetAliens());
+  m_obstaclesHash = SumHashes(m_space->GetObstacles());
+  m_spaceShipBulletsHash = SumHashes(m_space->GetSpaceShipBullets());
+  m_alienBulletsHash = SumHashes(m_space->GetAlienBullets());
+}
+
+uint64_t World::GetHistoryHash() const
+{
+  return m_historyHash;
+}
+
+void World::Save(Snapshot & snapshot) const
+{
+  snapshot.Write(kSnapshotMagic);
+  snapshot.Write(kSnapshotVersion);
+
+  snapshot.Write(m_level);
+  snapshot.Write(m_tick);
+  snapshot.Write(m_historyHash);
+  snapshot.Write(m_score);
+  snapshot.Write(m_gameState);
+  snapshot.Write(m_directions);
+  snapshot.Write(m_context.m_fieldSize.width());
+  snapshot.Write(m_context.m_fieldSize.height());
+
+  snapshot.Write(m_starsRandom.GetState());
+  snapshot.Write(m_starsRandom.GetIncrement());
+  snapshot.Write(m_aliensRandom.GetState());
+  snapshot.Write(m_aliensRandom.GetIncrement());
+  snapshot.Write(m_particlesRandom.GetState());
+  snapshot.Write(m_particlesRandom.GetIncrement());
+
+  snapshot.Write(static_cast<uint32_t>(m_random.size()));
+  for (auto const & star : m_random)
+  {
+    snapshot.Write(star.m_randomStar.first);
+    snapshot.Write(star.m_randomStar.second);
+    snapshot.Write(star.m_periodStar);
+  }
+
+  m_space->GetSpaceShip()->Save(snapshot);
+
+  m_formation.Save(snapshot);
+
+  m_waves.Save(snapshot);
+
+  m_particles.Save(snapshot);
+
+  SaveList(snapshot, m_space->GetAliens());
+  SaveList(snapshot, m_space->GetObstacles());
+  SaveList(snapshot, m_space->GetSpaceShipBullets());
+  SaveList(snapshot, m_space->GetAlienBullets());
+}
+
+void World::Restore(Snapshot & snapshot)
+{
+  snapshot.Rewind();
+
+  if (snapshot.Read<uint32_t>() != kSnapshotMagic ||
+      snapshot.Read<uint32_t>() != kSnapshotVersion ||
+      snapshot.Read<size_t>() != m_level)
+  {
+    throw ReadSnapshotException();
+  }
+
+  snapshot.Read(m_tick);
+  snapshot.Read(m_historyHash);
+  snapshot.Read(m_score);
+  snapshot.Read(m_gameState);
+  snapshot.Read(m_directions);
+  int const width = snapshot.Read<int>();
+  m_context.m_fieldSize = QSize(width, snapshot.Read<int>());
+
+  uint64_t const starsState = snapshot.Read<uint64_t>();
+  m_starsRandom.SetState(starsState, snapshot.Read<uint64_t>());
+  uint64_t const aliensState = snapshot.Read<uint64_t>();
+  m_aliensRandom.SetState(aliensState, snapshot.Read<uint64_t>());
+  uint64_t const particlesState = snapshot.Read<uint64_t>();
+  m_particlesRandom.SetState(particlesState, snapshot.Read<uint64_t>());
+
+  m_random.resize(snapshot.Read<uint32_t>());
+  for (auto & star : m_random)
+  {
+    snapshot.Read(star.m_randomStar.first);
+    snapshot.Read(star.m_randomStar.second);
+    snapshot.Read(star.m_periodStar);
+  }
+
+  if (m_space->GetSpaceShip() == nullptr)
+  {
+    AddSpaceShip();
+  }
+  m_space->GetSpaceShip()->Restore(snapshot);
+
+  m_formation.Restore(snapshot);
+
+  m_waves.Restore(snapshot, m_context.m_parameters);
+
+  m_particles.Restore(snapshot);
+
+  RestoreList(snapshot, m_space->GetAliens(), []()
+  {
+    return std::make_shared<Alien>(0, QVector2D(), 0, 0, TSize(), 0);
+  });
+
+  m_formation.UpdateBounds(m_space->GetAliens());
+
+  RestoreList(snapshot, m_space->GetObstacles(), []()
+  {
+    return std::make_shared<Obstacle>(0, QVector2D(), TSize());
+  });
+
+  RestoreList(snapshot, m_space->GetSpaceShipBullets(), []()
+  {
+    return std::make_shared<Bullet>(QVector2D(), 0, TSize());
+  });
+
+  RestoreList(snapshot, m_space->GetAlienBullets(), []()
+  {
+    return std::make_shared<Bullet>(QVector2D(), 0, TSize());
+  });
+
+  RehashEntities();
+}
+
+std::shared_ptr<Space> const & World::GetSpace() const
+{
+  return m_space;
+}
+
+std::vector<RandomStar> const & World::GetRandomStars() const
+{
+  return m_random;
+}
+
+ParticleSystem const & World::GetParticles() const
+{
+  return m_particles;
+}
+
+ParticleSystem & World::GetParticles()
+{
+  return m_particles;
+}
+
+GameState World::GetGameState() const
+{
+  return m_gameState;
+}
+
+size_t World::GetScore() const
+{
+  return m_score;
+}
+
+size_t World::GetLevel() const
+{
+  return m_level;
+}
+
+uint64_t World::GetCollisionTests() const
+{
+  return m_collisionTests;
+}
+
+FrameArena const & World::GetFrameArena() const
+{
+  return m_frameArena;
+}
+
+uint64_t World::GetTick() const
+{
+  return m_tick;
+}
+
+QSize World::GetFieldSize() const
+{
+  return m_context.m_fieldSize;
+}
+
+void World::SpawnLogic(float const & elapsedSeconds)
+{
+  m_waves.Advance(elapsedSeconds);
+
+  size_t const budget = m_context.m_parameters.m_mainParameters.m_spawnBudget;
+
+  m_spawnBuffer.clear();
+
+  SpawnEvent event;
+  while (m_spawnBuffer.size() < budget && m_waves.Next(event))
+  {
+    m_spawnBuffer.push_back(event);
+  }
+
+  // Aliens of one wave are created in one block.
+  for (size_t begin = 0; begin < m_spawnBuffer.size();)
+  {
+    size_t end = begin + 1;
+
+    while (end < m_spawnBuffer.size() && m_spawnBuffer[end].m_wave == m_spawnBuffer[begin].m_wave)
+    {
+      ++end;
+    }
+
+    SpawnAliens(begin, end);
+
+    begin = end;
+  }
+}
+
+void World::SpawnAliens(size_t begin, size_t end)
+{
+  WaveParameters const & wave = m_waves.GetWave(m_spawnBuffer[begin].m_wave);
+
+  Alien const prototype(m_context.m_parameters.m_alienParameters.m_speed,
+                        QVector2D(),
+                        m_context.m_parameters.m_alienParameters.m_rate,
+                        wave.m_health,
+                        wave.m_size,
+                        wave.m_frequency);
+
+  m_space->SpawnAliens(end - begin, prototype, [this, begin, &wave](size_t i, Alien & alien)
+  {
+    SpawnEvent const & event = m_spawnBuffer[begin + i];
+
+    alien.SetFormationOffset(event.m_place);
+
+    if (wave.m_path != WavePath::None)
+    {
+      QVector2D start;
+      QVector2D control;
+      m_waves.GetEntryPath(event, start, control);
+
+      alien.SetEntryPath(start, control, wave.m_pathTime);
+    }
+
+    m_formation.ApplyTo(alien);
+  });
+
+  m_formation.Invalidate();
+}
+
+void World::AddSpaceShip()
+{  
+  int health = m_context.m_parameters.m_spaceShipParameters.m_health;
+  uint rate = m_context.m_parameters.m_spaceShipParameters.m_rate;
+  TSize size = m_context.m_parameters.m_spaceShipParameters.m_size;
+
+  SpaceShip const spaceShip(QVector2D(m_context.m_fieldSize.width() / 2, size.second),
+                            rate,
+                            health,
+                            size);
+
+  // The space ship of the previous game is reused.
+  if (m_space->GetSpaceShip() != nullptr)
+  {
+    *m_space->GetSpaceShip() = spaceShip;
+  }
+  else
+  {
+    m_space->SetSpaceShip(std::make_shared<SpaceShip>(spaceShip));
+  }
+}
+
+void World::AddObstacles()
+{  
+  size_t obstaclesNumber = m_context.m_parameters.m_obstacleParameters.m_number;
+  int health = m_context.m_parameters.m_obstacleParameters.m_health;
+  TSize size = m_context.m_parameters.m_obstacleParameters.m_size;
+
+  size_t width = m_context.m_parameters.m_obstacleParameters.m_width;
+
+  size_t r = (m_context.m_fieldSize.width() / obstaclesNumber);
+
+  Obstacle const prototype(health, QVector2D(), size);
+
+  m_space->SpawnObstacles(obstaclesNumber, prototype, [r, width](size_t i, Obstacle & obstacle)
+  {
+    obstacle.SetPosition(QVector2D(i*r + width, 300));
+  });
+}
+
+void World::SetJobSystem(JobSystem * jobSystem)
+{
+  m_jobSystem = jobSystem;
+}
+
+void World::Tick(float const & elapsedSeconds)
+{
+  MemoryScope scope(MemoryTag::Space);
+
+  // Data of the previous step isn't used any more.
+  m_frameArena.Reset();
+
+  // New aliens take part in the whole step.
+  SpawnLogic(elapsedSeconds);
+
+  if (m_jobSystem != nullptr && m_jobSystem->GetSize() > 1)
+  {
+    TickParallel(elapsedSeconds);
+  }
+  else
+  {
+    TickSerial(elapsedSeconds);
+  }
+
+  m_tick++;
+
+  m_historyHash = Snapshot::Combine(m_historyHash, Hash());
+}
+
+void World::TickParallel(float const & elapsedSeconds)
+{
+  JobSystem & jobs = *m_jobSystem;
+
+  // A stage waits for the previous stages which use the same entities.
+  // Particles are emitted by the hit checks in the serial order.
+  auto const update = jobs.Add([this, elapsedSeconds]() { Update(elapsedSeconds); });
+  auto const gameOver = jobs.Add([this]() { IsGameOver(); });
+  auto const particles = jobs.Add([this, elapsedSeconds]() { ParticleLogic(elapsedSeconds); });
+  auto const aliens = jobs.Add([this, elapsedSeconds]() { AlienLogic(elapsedSeconds); });
+  jobs.Add([this]() { StarLogic(); });
+
+  auto const hitSpaceShip = jobs.Add([this]() { CheckHitSpaceShip(); },
+                                     { update, gameOver, particles });
+  auto const hitAlien = jobs.Add([this]() { CheckHitAlien(); },
+                                 { hitSpaceShip, aliens });
+
+  auto const shotAlien = jobs.Add([this]() { ShotAlien(); }, { hitAlien });
+  auto const spaceShipBullets = jobs.Add([this, elapsedSeconds]()
+  {
+    SpaceShipBulletsLogic(elapsedSeconds);
+  }, { hitAlien });
+  auto const alienBullets = jobs.Add([this, elapsedSeconds]()
+  {
+    AlienBulletsLogic(elapsedSeconds);
+  }, { shotAlien });
+
+  auto const hitObstacle = jobs.Add([this]() { CheckHitObstacle(); },
+                                    { spaceShipBullets, alienBullets });
+  jobs.Add([this]() { CheckSpaceShipCollision(); }, { hitObstacle });
+
+  jobs.Run();
+}
+
+void World::TickSerial(float const & elapsedSeconds)
+{
+  Update(elapsedSeconds);
+
+  IsGameOver();
+
+  ParticleLogic(elapsedSeconds);
+
+  // It throws an error.
+  CheckHitSpaceShip();
+
+  AlienLogic(elapsedSeconds);
+
+  CheckHitAlien();
+
+  ShotAlien();
+
+  SpaceShipBulletsLogic(elapsedSeconds);
+
+  AlienBulletsLogic(elapsedSeconds);
+
+  CheckHitObstacle();
+
+  CheckSpaceShipCollision();
+
+  /// Set to zero if it reaches the 1.0 .
+  StarLogic();
+}
+
+void World::Update(float elapsedSeconds)
+{
+  float const kSpeed = m_context.m_parameters.m_spaceShipParameters.m_speed; // pixels per second.
+
+  if (m_directions[kUpDirection])
+  {
+    m_space->GetSpaceShip()->IncreaseY(kSpeed * elapsedSeconds, m_context.m_fieldSize);
+  }
+  if (m_directions[kDownDirection])
+  {
+    m_space->GetSpaceShip()->DecreaseY(kSpeed * elapsedSeconds, m_context.m_fieldSize);
+  }
+  if (m_directions[kLeftDirection])
+  {
+    m_space->GetSpaceShip()->DecreaseX(kSpeed * elapsedSeconds, m_context.m_fieldSize);
+  }
+  if (m_directions[kRightDirection])
+  {
+    m_space->GetSpaceShip()->IncreaseX(kSpeed * elapsedSeconds, m_context.m_fieldSize);
+  }
+}
+
+void World::IsGameOver()
+{
+  if (m_space->GetSpaceShip()->GetHealth() <= 0)
+  {
+    m_gameState = GameState::LOSE;
+  }
+  else
+  {
+    std::list<TAlienPtr> & lstAlien = m_space->GetAliens();
+
+    if (lstAlien.empty() && m_waves.IsFinished())
+    {
+      m_gameState = GameState::WIN;
+    }
+  }
+}
+
+void World::AddStars()
+{
+  size_t starsNumber = m_context.m_parameters.m_starParameters.m_number;
+  TSize size = m_context.m_parameters.m_starParameters.m_size;
+
+  Star const prototype(QVector2D(200, 600), size);
+
+  m_random.reserve(m_random.size() + starsNumber);
+
+  m_space->SpawnStars(starsNumber, prototype, [this](size_t, Star &)
+  {
+    RandomStar randomStar;
+    randomStar.m_periodStar = m_starsRandom.NextFloat();
+    randomStar.m_randomStar = std::make_pair(m_starsRandom.NextFloat(),
+                                             m_starsRandom.NextFloat());
+    m_random.push_back(randomStar);
+  });
+}
+
+void World::CheckHitSpaceShip()
+{
+  Box2D const & spaceShipBox = m_space->GetSpaceShip()->GetBox();
+
+  Box2D bulletsBounds;
+  TFrameVector<Box2D> bulletBoxes(m_frameArena);
+  Collision::Gather(m_space->GetAlienBullets(), m_alienBulletsBuffer, bulletBoxes, bulletsBounds);
+
+  // All bullets are away from the space ship.
+  if (!Box2D::checkBoxes(spaceShipBox, bulletsBounds))
+  {
+    return;
+  }
+
+  // Detect.
+  m_alienBulletsUsed.assign(bulletBoxes.size(), 0);
+
+  TFrameVector<Contact> contacts(m_frameArena);
+  contacts.reserve(bulletBoxes.size());
+  Collision::Detect(0, spaceShipBox, bulletBoxes,
+                    m_alienBulletsUsed, 0, 0, contacts, m_collisionTests);
+
+  if (contacts.empty())
+  {
+    return;
+  }
+
+  // Resolve.
+  for (Contact const & contact : contacts)
+  {
+    Bullet const & bullet = *m_alienBulletsBuffer[contact.m_other];
+
+    KillSpaceShip(bullet.GetDamage(), bullet.GetPosition());
+
+    m_alienBulletsHash -= EntityHash(bullet);
+  }
+
+  m_space->RemoveAlienBullets(m_alienBulletsUsed);
+}
+
+void World::KillSpaceShip(uint damage, QVector2D const position)
+{
+  int health = m_space->GetSpaceShip()->GetHealth();
+
+  int health_updated = health - damage;
+
+  if (health_updated > 0)
+  {
+    SpawnExplosion(position, true);
+
+    m_space->GetSpaceShip()->SetHealth(health_updated);
+  }
+  else
+  {
+    m_gameState = GameState::LOSE;
+  }
+}
+
+void World::SpawnExplosion(QVector2D const & position, bool big)
+{
+  ExplosionParameters const & parameters = m_context.m_parameters.m_explosionParameters;
+
+  TSize const & size = big ? parameters.m_sizeBig : parameters.m_size;
+  float const lifetime = (big ? parameters.m_lifetimeBig : parameters.m_lifetime) * kFixedTimeStep;
+
+  m_particles.Emit(position, QVector2D(), lifetime, size);
+
+  // Debris flies apart evenly from a random angle.
+  size_t const debris = big ? 2 * parameters.m_particles : parameters.m_particles;
+  float const angle = m_particlesRandom.NextFloat(0.0f, 2.0f * Constants::PI);
+  TSize const debrisSize(size.first / 4, size.second / 4);
+
+  for (size_t i = 0; i < debris; ++i)
+  {
+    float const direction = angle + 2.0f * Constants::PI * i / debris;
+    float const speed = parameters.m_speed * m_particlesRandom.NextFloat(0.5f, 1.0f);
+
+    m_particles.Emit(position,
+                     QVector2D(std::cos(direction), std::sin(direction)) * speed,
+                     lifetime * m_particlesRandom.NextFloat(0.5f, 1.0f),
+                     debrisSize);
+  }
+}
+
+void World::CheckHitAlien()
+{
+  Box2D bounds;
+  TFrameVector<Box2D> bulletBoxes(m_frameArena);
+  Collision::Gather(m_space->GetSpaceShipBullets(), m_spaceShipBulletsBuffer,
+                    bulletBoxes, bounds);
+
+  // The formation is away from all bullets.
+  if (!Box2D::checkBoxes(m_formation.GetBounds(), bounds))
+  {
+    return;
+  }
+
+  TFrameVector<Box2D> alienBoxes(m_frameArena);
+  Collision::Gather(m_space->GetAliens(), m_aliensBuffer, alienBoxes, bounds);
+  m_spaceShipBulletsUsed.assign(bulletBoxes.size(), 0);
+
+  // Detect. A bullet hits the first alien in the list order,
+  // an alien takes all bullets which are left.
+  TFrameVector<Contact> contacts(m_frameArena);
+  contacts.reserve(bulletBoxes.size());
+  for (size_t i = 0; i < alienBoxes.size(); ++i)
+  {
+    Collision::Detect(static_cast<uint32_t>(i), alienBoxes[i], bulletBoxes,
+                      m_spaceShipBulletsUsed, 0, 0, contacts, m_collisionTests);
+  }
+
+  if (contacts.empty())
+  {
+    return;
+  }
+
+  // Resolve. Contacts are grouped by aliens in the list order.
+  m_targetsRemoved.assign(alienBoxes.size(), 0);
+
+  for (size_t i = 0; i < contacts.size(); ++i)
+  {
+    Contact const & contact = contacts[i];
+    Alien & alien = *m_aliensBuffer[contact.m_target];
+    Bullet const & bullet = *m_spaceShipBulletsBuffer[contact.m_other];
+
+    // The hash of the alien is taken out before its first hit
+    // and put back after the last one if it survived.
+    bool const isFirst = i == 0 || contacts[i - 1].m_target != contact.m_target;
+
+    if (isFirst)
+    {
+      m_aliensHash -= EntityHash(alien);
+    }
+
+    m_spaceShipBulletsHash -= EntityHash(bullet);
+
+    int health = alien.GetHealth();
+
+    uint damage = bullet.GetDamage();
+
+    int health_updated = health - damage;
+
+    if (health_updated > 0)
+    {
+      SpawnExplosion(alien.GetPosition(), false);
+
+      alien.SetHealth(health_updated);
+    }
+    else
+    {
+      m_targetsRemoved[contact.m_target] = 1;
+    }
+
+    // The big explosion follows the last hit of the alien.
+    bool const isLast = i + 1 == contacts.size() ||
+                        contacts[i + 1].m_target != contact.m_target;
+
+    if (isLast && m_targetsRemoved[contact.m_target])
+    {
+      SpawnExplosion(alien.GetPosition(), true);
+
+      m_score += m_context.m_parameters.m_alienParameters.m_score;
+    }
+    else if (isLast)
+    {
+      m_aliensHash += EntityHash(alien);
+    }
+  }
+
+  m_space->RemoveSpaceShipBullets(m_spaceShipBulletsUsed);
+  m_space->RemoveAliens(m_targetsRemoved);
+}
+
+void World::ShotAlien()
+{
+  std::list<TAlienPtr> & lst = m_space->GetAliens();
+
+  for (auto it = begin(lst); it != end(lst); ++it)
+  {
+    if (abs(m_space->GetSpaceShip()->GetPosition().x()
+                - (*it)->GetPosition().x()) < m_context.m_fieldSize.width() / 2 && m_aliensRandom.NextFloat() <= 0.5f)
+    {
+      if ((*it)->Shot())
+      {
+        Bullet const bullet((*it)->GetPosition(),
+                            m_context.m_parameters.m_bulletParameters.m_damage,
+                            m_context.m_parameters.m_bulletParameters.m_size);
+
+        m_space->SpawnAlienBullet(bullet);
+        m_alienBulletsHash += EntityHash(bullet);
+      }
+    }
+  }
+}
+
+void World::ParticleLogic(float const & elapsedSeconds)
+{
+  m_particles.Update(elapsedSeconds);
+}
+
+void World::SpaceShipBulletsLogic(float const & elapsedSeconds)
+{
+  // Loop over space ship bullets and delete it if needed.
+  std::list<TBulletPtr> & lst = m_space->GetSpaceShipBullets();
+
+  float const distance = elapsedSeconds * m_space->GetSpaceShip()->GetRate();
+
+  // Every bullet moves, so the hash of the list is summed again by the move.
+  m_spaceShipBulletsHash = SumEachEntity(m_jobSystem, lst, m_spaceShipBulletsBuffer,
+                                         [this, distance](Bullet & bullet)
+  {
+    bullet.IncreaseY(distance, m_context.m_fieldSize);
+    return EntityHash(bullet);
+  });
+
+  for (auto it = begin(lst); it != end(lst);)
+  {
+    if (Culling::IsOutside((*it)->GetPosition(), (*it)->GetSize(), GetFieldSize()))
+    {
+      m_spaceShipBulletsHash -= EntityHash(**it);
+      it = m_space->RemoveSpaceShipBullet(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  // Check if needed.
+  //  qDebug() << "lst.size() = " << lst.size();
+}
+
+void World::AlienBulletsLogic(float const & elapsedSeconds)
+{
+  // Loop over space ship bullets and delete it if needed.
+  std::list<TBulletPtr> & lst = m_space->GetAlienBullets();
+
+  float const distance = elapsedSeconds * m_context.m_parameters.m_alienParameters.m_rate;
+
+  m_alienBulletsHash = SumEachEntity(m_jobSystem, lst, m_alienBulletsBuffer,
+                                     [this, distance](Bullet & bullet)
+  {
+    bullet.DecreaseY(distance, m_context.m_fieldSize);
+    return EntityHash(bullet);
+  });
+
+  for (auto it = begin(lst); it != end(lst);)
+  {
+    // Bullets also leave through the side walls after a resize.
+    if (Culling::IsOutside((*it)->GetPosition(), (*it)->GetSize(), GetFieldSize()))
+    {
+      m_alienBulletsHash -= EntityHash(**it);
+      it = m_space->RemoveAlienBullet(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  // Check if needed.
+  //  qDebug() << "lst.size() = " << lst.size();
+}
+
+void World::AlienLogic(float const & elapsedSeconds)
+{
+  std::list<TAlienPtr> & lst = m_space->GetAliens();
+
+  // Aliens on their entry paths change their offsets.
+  if (m_waves.IsEntering())
+  {
+    ForEachEntity(m_jobSystem, lst, m_aliensBuffer, [elapsedSeconds](Alien & alien)
+    {
+      alien.UpdateEntryPath(elapsedSeconds);
+    });
+
+    m_formation.Invalidate();
+  }
+
+  // Move the whole formation once, then derive positions of the aliens.
+  m_formation.Update(elapsedSeconds, lst, m_context.m_fieldSize);
+
+  // The hash of the list is summed together with the positions.
+  m_aliensHash = SumEachEntity(m_jobSystem, lst, m_aliensBuffer, [this](Alien & alien)
+  {
+    m_formation.ApplyTo(alien);
+    return EntityHash(alien);
+  });
+}
+
+void World::CheckHitObstacle()
+{
+  Box2D obstaclesBounds;
+  Box2D alienBulletsBounds;
+  Box2D spaceShipBulletsBounds;
+  TFrameVector<Box2D> obstacleBoxes(m_frameArena);
+  TFrameVector<Box2D> alienBulletBoxes(m_frameArena);
+  TFrameVector<Box2D> spaceShipBulletBoxes(m_frameArena);
+  Collision::Gather(m_space->GetObstacles(), m_obstaclesBuffer, obstacleBoxes, obstaclesBounds);
+  Collision::Gather(m_space->GetAlienBullets(), m_alienBulletsBuffer,
+                    alienBulletBoxes, alienBulletsBounds);
+  Collision::Gather(m_space->GetSpaceShipBullets(), m_spaceShipBulletsBuffer,
+                    spaceShipBulletBoxes, spaceShipBulletsBounds);
+
+  // The obstacle row is away from all bullets.
+  if (!Box2D::checkBoxes(obstaclesBounds, alienBulletsBounds) &&
+      !Box2D::checkBoxes(obstaclesBounds, spaceShipBulletsBounds))
+  {
+    return;
+  }
+
+  m_alienBulletsUsed.assign(alienBulletBoxes.size(), 0);
+  m_spaceShipBulletsUsed.assign(spaceShipBulletBoxes.size(), 0);
+
+  // Detect. An obstacle takes one alien bullet and then
+  // one space ship bullet if the first one didn't destroy it.
+  TFrameVector<Contact> contacts(m_frameArena);
+  contacts.reserve(alienBulletBoxes.size() + spaceShipBulletBoxes.size());
+  for (size_t i = 0; i < obstacleBoxes.size(); ++i)
+  {
+    uint32_t const target = static_cast<uint32_t>(i);
+
+    if (Collision::Detect(target, obstacleBoxes[i], alienBulletBoxes,
+                          m_alienBulletsUsed, kAlienBulletsGroup, 1,
+                          contacts, m_collisionTests) > 0)
+    {
+      int health = m_obstaclesBuffer[i]->GetHealth();
+
+      uint damage = m_alienBulletsBuffer[contacts.back().m_other]->GetDamage();
+
+      int health_updated = health - damage;
+
+      if (health_updated <= 0)
+      {
+        continue;
+      }
+    }
+
+    Collision::Detect(target, obstacleBoxes[i], spaceShipBulletBoxes,
+                      m_spaceShipBulletsUsed, kSpaceShipBulletsGroup, 1,
+                      contacts, m_collisionTests);
+  }
+
+  if (contacts.empty())
+  {
+    return;
+  }
+
+  // Resolve. Contacts are grouped by obstacles in the list order.
+  m_targetsRemoved.assign(obstacleBoxes.size(), 0);
+
+  for (size_t i = 0; i < contacts.size(); ++i)
+  {
+    Contact const & contact = contacts[i];
+    Obstacle & obstacle = *m_obstaclesBuffer[contact.m_target];
+
+    bool const isAlienBullet = contact.m_group == kAlienBulletsGroup;
+    Bullet const & bullet = isAlienBullet ? *m_alienBulletsBuffer[contact.m_other]
+                                          : *m_spaceShipBulletsBuffer[contact.m_other];
+
+    bool const isFirst = i == 0 || contacts[i - 1].m_target != contact.m_target;
+
+    if (isFirst)
+    {
+      m_obstaclesHash -= EntityHash(obstacle);
+    }
+
+    (isAlienBullet ? m_alienBulletsHash : m_spaceShipBulletsHash) -= EntityHash(bullet);
+
+    int health = obstacle.GetHealth();
+
+    uint damage = bullet.GetDamage();
+
+    int health_updated = health - damage;
+
+    if (health_updated > 0)
+    {
+      SpawnExplosion(obstacle.GetPosition(), false);
+
+      obstacle.SetHealth(health_updated);
+    }
+    else
+    {
+      m_targetsRemoved[contact.m_target] = 1;
+    }
+
+    // Make explosion if needed.
+    bool const isLast = i + 1 == contacts.size() ||
+                        contacts[i + 1].m_target != contact.m_target;
+
+    if (isLast && m_targetsRemoved[contact.m_target])
+    {
+      SpawnExplosion(obstacle.GetPosition(), true);
+
+      m_score += m_context.m_parameters.m_obstacleParameters.m_score;
+    }
+    else if (isLast)
+    {
+      m_obstaclesHash += EntityHash(obstacle);
+    }
+  }
+
+  m_space->RemoveAlienBullets(m_alienBulletsUsed);
+  m_space->RemoveSpaceShipBullets(m_spaceShipBulletsUsed);
+  m_space->RemoveObstacles(m_targetsRemoved);
+}
+
+void World::StarLogic()
+{
+  for (auto it = m_random.begin() ; it != m_random.end(); ++it)
+  {
+    if((*it).m_periodStar < 1.0)
+    {
+      (*it).m_periodStar += 0.001f;
+    }
+    else
+    {
+      (*it).m_randomStar = std::make_pair(m_starsRandom.NextFloat(),
+                                          m_starsRandom.NextFloat());
+      (*it).m_periodStar = 0.0f;
+    }
+  }
+}
+
+void World::SetPosition(int w, int h)
+{
+  QSize const & fieldSize = m_context.m_fieldSize;
+
+  QVector2D position = m_space->GetSpaceShip()->GetPosition();
+  m_space->GetSpaceShip()->SetPosition(QVector2D(position.x()*w/fieldSize.width(),position.y()*h/fieldSize.height()));
+
+  for (auto obstacle : m_space->GetObstacles())
+  {
+    position = obstacle->GetPosition();
+    obstacle->SetPosition(QVector2D(position.x()*w/fieldSize.width(),position.y()*h/fieldSize.height()));
+  }
+
+  m_formation.Scale(m_space->GetAliens(),
+                    static_cast<float>(w) / fieldSize.width(),
+                    static_cast<float>(h) / fieldSize.height());
+
+  m_waves.Scale(static_cast<float>(w) / fieldSize.width(),
+                static_cast<float>(h) / fieldSize.height());
+
+  m_particles.Scale(static_cast<float>(w) / fieldSize.width(),
+                    static_cast<float>(h) / fieldSize.height());
+
+  for (auto bullet : m_space->GetAlienBullets())
+  {
+    position = bullet->GetPosition();
+    bullet->SetPosition(QVector2D(position.x()*w/fieldSize.width(),position.y()*h/fieldSize.height()));
+  }
+
+  for (auto bullet : m_space->GetSpaceShipBullets())
+  {
+    position = bullet->GetPosition();
+    bullet->SetPosition(QVector2D(position.x()*w/fieldSize.width(),position.y()*h/fieldSize.height()));
+  }
+
+  RehashEntities();
+}
+
+void World::CheckSpaceShipCollision()
+{
+  Box2D const spaceShipBox = m_space->GetSpaceShip()->GetBox();
+
+  // Obstacles and aliens which touch the space ship are destroyed with it.
+  Box2D obstaclesBounds;
+  TFrameVector<Box2D> obstacleBoxes(m_frameArena);
+  Collision::Gather(m_space->GetObstacles(), m_obstaclesBuffer, obstacleBoxes, obstaclesBounds);
+
+  TFrameVector<Contact> contacts(m_frameArena);
+
+  if (Box2D::checkBoxes(spaceShipBox, obstaclesBounds))
+  {
+    m_targetsRemoved.assign(obstacleBoxes.size(), 0);
+
+    contacts.reserve(obstacleBoxes.size());
+    if (Collision::Detect(0, spaceShipBox, obstacleBoxes, m_targetsRemoved,
+                          0, 0, contacts, m_collisionTests) > 0)
+    {
+      for (Contact const & contact : contacts)
+      {
+        m_obstaclesHash -= EntityHash(*m_obstaclesBuffer[contact.m_other]);
+      }
+
+      m_space->GetSpaceShip()->SetHealth(0);
+      m_space->RemoveObstacles(m_targetsRemoved);
+    }
+  }
+
+  // Aliens are gathered only if the formation is near the space ship.
+  if (Box2D::checkBoxes(spaceShipBox, m_formation.GetBounds()))
+  {
+    Box2D aliensBounds;
+    TFrameVector<Box2D> alienBoxes(m_frameArena);
+    Collision::Gather(m_space->GetAliens(), m_aliensBuffer, alienBoxes, aliensBounds);
+    m_targetsRemoved.assign(alienBoxes.size(), 0);
+
+    contacts.clear();
+    contacts.reserve(alienBoxes.size());
+    if (Collision::Detect(0, spaceShipBox, alienBoxes, m_targetsRemoved,
+                          0, 0, contacts, m_collisionTests) > 0)
+    {
+      for (Contact const & contact : contacts)
+      {
+        m_aliensHash -= EntityHash(*m_aliensBuffer[contact.m_other]);
+      }
+
+      m_space->GetSpaceShip()->SetHealth(0);
+      m_space->RemoveAliens(m_targetsRemoved);
+    }
+  }
+}
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <QSize>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "space.hpp"
+#include "game_state.hpp"
+#include "random.hpp"
+#include "input_command.hpp"
+#include "snapshot.hpp"
+#include "game_context.hpp"
+#include "job_system.hpp"
+#include "collision.hpp"
+#include "formation.hpp"
+#include "wave_script.hpp"
+#include "particle_system.hpp"
+#include "frame_arena.hpp"
+
+struct RandomStar
+{
+  std::pair<float,float> m_randomStar;
+  float m_periodStar;
+};
+
+///
+/// The game logic of one level.
+///
+/// It doesn't depend on a widget or a GL context,
+/// so it can run without rendering.
+///
+class World
+{
+public:
+  /// Simulation step of the fixed step mode in seconds.
+  static float constexpr kFixedTimeStep = 1.0f / 60.0f;
+
+  ///
+  /// The context is taken from the loaded settings.
+  ///
+  World(size_t const & level = 1);
+  World(GameContext const & context, size_t const & level = 1);
+
+  ///
+  /// Create game objects. Settings must be loaded before.
+  ///
+  void Initialize();
+
+  ///
+  /// Create game objects with the given seed of the random streams.
+  ///
+  void Initialize(uint64_t seed);
+
+  ///
+  /// Start the level again with the given seed.
+  ///
+  /// The state is the same as of a new initialized world, but the space,
+  /// the particle buffer, the frame arena and the buffers of the passes
+  /// are reused, so a new episode doesn't allocate them again.
+  /// The field size is kept.
+  ///
+  void Reset(uint64_t seed);
+
+  ///
+  /// Advance the game logic by one step.
+  ///
+  void Tick(float const & elapsedSeconds);
+
+  ///
+  /// Run independent stages of the tick and long loops on the job system.
+  ///
+  /// The stages keep the order of the serial tick for every piece
+  /// of the state, so the result doesn't depend on the job system.
+  /// Nullptr runs everything on the calling thread.
+  ///
+  void SetJobSystem(JobSystem * jobSystem);
+
+  ///
+  /// Apply a player command.
+  ///
+  void Apply(InputCommand const & command);
+
+  ///
+  /// Hash of the game state. It is used to verify replays.
+  ///
+  /// It costs nothing per entity. Every list keeps the sum of the hashes
+  /// of its entities, which is updated where they are added, removed or
+  /// damaged. Aliens and bullets move on every step, so their sums are
+  /// taken again by the parallel passes which move them. A list is hashed
+  /// as a set, the order of its entities isn't a part of the hash.
+  /// Entities added to the space directly are seen from the next step.
+  ///
+  uint64_t Hash() const;
+
+  ///
+  /// Hash of all states since the start of the level.
+  ///
+  /// It is chained on every tick, so two sessions which diverged
+  /// at some point differ even if they end in the same state.
+  ///
+  uint64_t GetHistoryHash() const;
+
+  ///
+  /// Write the whole game state to a snapshot.
+  ///
+  void Save(Snapshot & snapshot) const;
+
+  ///
+  /// Return to the state stored by Save().
+  ///
+  /// Entities which already exist are reused, so restoring
+  /// a recent snapshot doesn't allocate.
+  ///
+  /// Exception: ReadSnapshotException.
+  ///
+  void Restore(Snapshot & snapshot);
+
+  std::shared_ptr<Space> const & GetSpace() const;
+  std::vector<RandomStar> const & GetRandomStars() const;
+  ParticleSystem const & GetParticles() const;
+  ParticleSystem & GetParticles();
+  GameState GetGameState() const;
+  size_t GetScore() const;
+  size_t GetLevel() const;
+  uint64_t GetTick() const;
+
+  ///
+  /// Number of box pairs tested by the collision passes.
+  /// It is a statistic, it isn't a part of the game state.
+  ///
+  uint64_t GetCollisionTests() const;
+
+  ///
+  /// Memory of the last step. It is a statistic too.
+  ///
+  FrameArena const & GetFrameArena() const;
+  QSize GetFieldSize() const;
+
+protected:
+  void Update(float elapsedSeconds);
+
+  /// Set m_isGameOver to true if game is over.
+  void IsGameOver();
+
+  /// Create objects.
+  void AddObstacles();
+  void AddSpaceShip();
+  void AddStars();
+
+  ///
+  /// Advance the waves and create the aliens which are due.
+  ///
+  void SpawnLogic(float const & elapsedSeconds);
+
+  ///
+  /// Create the aliens of the events [begin, end) of the spawn buffer.
+  /// The events must belong to one wave.
+  ///
+  void SpawnAliens(size_t begin, size_t end);
+
+  /// Logic stage.
+  void CheckHitAlien();
+  void CheckHitSpaceShip();
+  void KillSpaceShip(uint damage, QVector2D const position);
+
+  ///
+  /// Emit a flash in the place and debris around it.
+  ///
+  void SpawnExplosion(QVector2D const & position, bool big);
+  void SpaceShipBulletsLogic(float const & elapsedSeconds);
+  void AlienBulletsLogic(float const & elapsedSeconds);
+  void AlienLogic(float const & elapsedSeconds);
+  void ShotAlien();
+  void ParticleLogic(float const & elapsedSeconds);
+  void CheckHitObstacle();
+  void StarLogic();
+  void SetPosition(int w, int h);
+  void CheckSpaceShipCollision();
+
+private:
+  void TickSerial(float const & elapsedSeconds);
+  void TickParallel(float const & elapsedSeconds);
+
+  void Fire();
+  void KillAliens();
+
+  ///
+  /// Sum the hashes of all lists again, it is used when
+  /// all entities change, e.g. on resize and restore.
+  ///
+  void RehashEntities();
+
+  // Parameters and field size of this game.
+  GameContext m_context;
+
+  // The current level number.
+  size_t m_level = 0;
+
+  std::vector<RandomStar> m_random;
+
+  std::shared_ptr<Space> m_space = nullptr;
+
+  // Aliens move as one group.
+  Formation m_formation;
+
+  // Aliens of the level appear by this script.
+  WaveScript m_waves;
+
+  // Explosions.
+  ParticleSystem m_particles;
+
+  std::array<bool, 4> m_directions = {{ false, false, false, false }};
+
+  // Random streams of the subsystems.
+  Pcg32 m_starsRandom;
+  Pcg32 m_aliensRandom;
+  Pcg32 m_particlesRandom;
+
+  // The number of simulated steps.
+  uint64_t m_tick = 0;
+
+  uint64_t m_historyHash = 0;
+
+  // Sums of the hashes of the entities of every list, see Hash().
+  // The stages of one list run one by one, so they need no lock.
+  uint64_t m_aliensHash = 0;
+  uint64_t m_obstaclesHash = 0;
+  uint64_t m_spaceShipBulletsHash = 0;
+  uint64_t m_alienBulletsHash = 0;
+
+  GameState m_gameState = GameState::STOP;
+
+  size_t m_score = 0;
+
+  JobSystem * m_jobSystem = nullptr;
+
+  // Entities of the chunked loops and the collision passes.
+  // They are kept to reuse the memory.
+  std::vector<Alien *> m_aliensBuffer;
+  std::vector<Bullet *> m_spaceShipBulletsBuffer;
+  std::vector<Bullet *> m_alienBulletsBuffer;
+  std::vector<Obstacle *> m_obstaclesBuffer;
+
+  // Events which are due in this step.
+  std::vector<SpawnEvent> m_spawnBuffer;
+
+  // Boxes and contacts of the collision passes. It is reset at the start
+  // of every step. The passes run one after another, no other stage uses it.
+  FrameArena m_frameArena;
+
+  // Marks of the collision passes. The space removes entities by them.
+  std::vector<uint8_t> m_targetsRemoved;
+  std::vector<uint8_t> m_alienBulletsUsed;
+  std::vector<uint8_t> m_spaceShipBulletsUsed;
+
+  uint64_t m_collisionTests = 0;
+};
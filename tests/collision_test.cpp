@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include "collision.hpp"
+
+namespace
+{
+
+Box2D MakeBox(float x, float y)
+{
+  return Box2D::createBox(Point2D(x, y), Point2D(x + 10.0f, y + 10.0f));
+}
+
+} // namespace
+
+TEST(collision_test, test_detect)
+{
+  std::vector<Box2D> boxes = { MakeBox(0.0f, 0.0f),
+                               MakeBox(100.0f, 0.0f),
+                               MakeBox(5.0f, 5.0f) };
+  std::vector<uint8_t> used(boxes.size(), 0);
+  std::vector<Contact> contacts;
+  uint64_t tests = 0;
+
+  EXPECT_EQ(Collision::Detect(7, MakeBox(2.0f, 2.0f), boxes, used, 1, 0, contacts, tests), 2);
+  ASSERT_EQ(contacts.size(), 2);
+  EXPECT_EQ(contacts[0].m_target, 7);
+  EXPECT_EQ(contacts[0].m_other, 0);
+  EXPECT_EQ(contacts[0].m_group, 1);
+  EXPECT_EQ(contacts[1].m_other, 2);
+  EXPECT_EQ(used, std::vector<uint8_t>({ 1, 0, 1 }));
+  EXPECT_EQ(tests, 3);
+
+  // Used boxes don't take part in other contacts.
+  EXPECT_EQ(Collision::Detect(8, MakeBox(2.0f, 2.0f), boxes, used, 1, 0, contacts, tests), 0);
+  EXPECT_EQ(contacts.size(), 2);
+  EXPECT_EQ(tests, 4);
+
+  // Touching boxes don't overlap.
+  EXPECT_EQ(Collision::Detect(9, MakeBox(110.0f, 0.0f), boxes, used, 1, 0, contacts, tests), 0);
+}
+
+TEST(collision_test, test_limit)
+{
+  std::vector<Box2D> boxes = { MakeBox(0.0f, 0.0f),
+                               MakeBox(1.0f, 1.0f),
+                               MakeBox(2.0f, 2.0f) };
+  std::vector<uint8_t> used(boxes.size(), 0);
+  std::vector<Contact> contacts;
+  uint64_t tests = 0;
+
+  EXPECT_EQ(Collision::Detect(0, MakeBox(0.0f, 0.0f), boxes, used, 0, 1, contacts, tests), 1);
+  EXPECT_EQ(Collision::Detect(1, MakeBox(0.0f, 0.0f), boxes, used, 0, 1, contacts, tests), 1);
+  ASSERT_EQ(contacts.size(), 2);
+  EXPECT_EQ(contacts[0].m_other, 0);
+  EXPECT_EQ(contacts[1].m_other, 1);
+  EXPECT_EQ(contacts[1].m_target, 1);
+}
@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+#include "formation.hpp"
+
+namespace
+{
+
+std::list<TAlienPtr> MakeRow(size_t number, float spacing)
+{
+  std::list<TAlienPtr> aliens;
+
+  for (size_t i = 0; i < number; ++i)
+  {
+    QVector2D const position(i * spacing, 100.0f);
+
+    auto alien = std::make_shared<Alien>(0, position, 0, 1, TSize(10, 10), 1);
+    alien->SetFormationOffset(position);
+    aliens.push_back(alien);
+  }
+
+  return aliens;
+}
+
+} // namespace
+
+TEST(formation_test, test_move)
+{
+  auto aliens = MakeRow(3, 20.0f);
+  Formation formation(100.0f, 5.0f);
+
+  formation.Update(0.5f, aliens, QSize(200, 200));
+
+  EXPECT_FLOAT_EQ(formation.GetOffset().x(), 50.0f);
+  EXPECT_FLOAT_EQ(formation.GetOffset().y(), 0.0f);
+
+  // All aliens move by the same offset.
+  for (auto const & alien : aliens)
+  {
+    formation.ApplyTo(*alien);
+    EXPECT_FLOAT_EQ(alien->GetPosition().x(), alien->GetFormationOffset().x() + 50.0f);
+    EXPECT_FLOAT_EQ(alien->GetPosition().y(), 100.0f);
+  }
+}
+
+TEST(formation_test, test_bounce)
+{
+  // The formation is 50 pixels wide.
+  auto aliens = MakeRow(3, 20.0f);
+  Formation formation(100.0f, 5.0f);
+
+  // Stop at the right wall, turn back and step down.
+  formation.Update(2.0f, aliens, QSize(200, 200));
+  EXPECT_FLOAT_EQ(formation.GetOffset().x(), 150.0f);
+  EXPECT_FLOAT_EQ(formation.GetOffset().y(), -5.0f);
+  EXPECT_FLOAT_EQ(formation.GetVelocity(), -100.0f);
+
+  formation.Update(1.0f, aliens, QSize(200, 200));
+  EXPECT_FLOAT_EQ(formation.GetOffset().x(), 50.0f);
+
+  // The same at the left wall.
+  formation.Update(1.0f, aliens, QSize(200, 200));
+  EXPECT_FLOAT_EQ(formation.GetOffset().x(), 0.0f);
+  EXPECT_FLOAT_EQ(formation.GetOffset().y(), -10.0f);
+  EXPECT_FLOAT_EQ(formation.GetVelocity(), 100.0f);
+}
+
+TEST(formation_test, test_bounds_follow_aliens)
+{
+  auto aliens = MakeRow(3, 20.0f);
+  Formation formation(100.0f, 0.0f);
+
+  formation.Update(0.0f, aliens, QSize(200, 200));
+
+  // Without the right column the formation goes further.
+  aliens.pop_back();
+  formation.Update(2.0f, aliens, QSize(200, 200));
+  EXPECT_FLOAT_EQ(formation.GetOffset().x(), 170.0f);
+}
+
+TEST(formation_test, test_bounds_cover_aliens)
+{
+  auto aliens = MakeRow(3, 20.0f);
+  Formation formation(100.0f, 5.0f);
+
+  formation.Update(0.25f, aliens, QSize(200, 200));
+
+  Box2D const bounds = formation.GetBounds();
+
+  for (auto const & alien : aliens)
+  {
+    formation.ApplyTo(*alien);
+
+    // The cached box follows the derived position.
+    EXPECT_FLOAT_EQ(alien->GetBox().boxMin().x(), alien->GetPosition().x());
+    EXPECT_FLOAT_EQ(alien->GetBox().boxMax().y(), alien->GetPosition().y() + 10.0f);
+
+    EXPECT_LE(bounds.boxMin().x(), alien->GetBox().boxMin().x());
+    EXPECT_LE(bounds.boxMin().y(), alien->GetBox().boxMin().y());
+    EXPECT_GE(bounds.boxMax().x(), alien->GetBox().boxMax().x());
+    EXPECT_GE(bounds.boxMax().y(), alien->GetBox().boxMax().y());
+  }
+
+  // An empty formation doesn't overlap anything.
+  formation.UpdateBounds(std::list<TAlienPtr>());
+  EXPECT_EQ(Box2D::checkBoxes(formation.GetBounds(), bounds), false);
+}
@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+#include "frame_arena.hpp"
+
+TEST(frame_arena_test, test_allocate)
+{
+  FrameArena arena(64);
+  EXPECT_EQ(arena.GetHeapAllocations(), 1);
+
+  char * a = static_cast<char *>(arena.Allocate(3, 1));
+  uint64_t * b = static_cast<uint64_t *>(arena.Allocate(sizeof(uint64_t), alignof(uint64_t)));
+
+  // One block, the second allocation is aligned.
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % alignof(uint64_t), 0);
+  EXPECT_EQ(reinterpret_cast<char *>(b) - a, 8);
+  EXPECT_EQ(arena.GetUsed(), 16);
+  EXPECT_EQ(arena.GetAllocations(), 2);
+  EXPECT_EQ(arena.GetHeapAllocations(), 1);
+
+  arena.Reset();
+  EXPECT_EQ(arena.GetUsed(), 0);
+  EXPECT_EQ(arena.GetPeak(), 16);
+  EXPECT_EQ(arena.Allocate(3, 1), a);
+}
+
+TEST(frame_arena_test, test_grow)
+{
+  FrameArena arena;
+
+  // Requests which don't fit are served from the heap.
+  arena.Allocate(100, 4);
+  arena.Allocate(200, 4);
+  EXPECT_EQ(arena.GetHeapAllocations(), 2);
+  EXPECT_EQ(arena.GetUsed(), 300);
+
+  // The block grows at the reset, the same step fits it.
+  arena.Reset();
+  EXPECT_GE(arena.GetCapacity(), 300);
+  EXPECT_EQ(arena.GetHeapAllocations(), 3);
+
+  for (int i = 0; i < 10; ++i)
+  {
+    arena.Allocate(100, 4);
+    arena.Allocate(200, 4);
+    arena.Reset();
+  }
+
+  EXPECT_EQ(arena.GetHeapAllocations(), 3);
+  EXPECT_EQ(arena.GetPeak(), 300);
+}
+
+TEST(frame_arena_test, test_frame_vector)
+{
+  FrameArena arena(1024);
+
+  TFrameVector<int> numbers(arena);
+  numbers.reserve(16);
+
+  for (int i = 0; i < 16; ++i)
+  {
+    numbers.push_back(i);
+  }
+
+  TFrameVector<uint8_t> marks(16, 0, arena);
+  marks[3] = 1;
+
+  EXPECT_EQ(numbers[15], 15);
+  EXPECT_EQ(marks[3], 1);
+  EXPECT_EQ(arena.GetAllocations(), 2);
+  EXPECT_EQ(arena.GetUsed(), 16 * sizeof(int) + 16);
+  EXPECT_EQ(arena.GetHeapAllocations(), 1);
+}
@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+#include "input_log.hpp"
+#include "except.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+TEST(input_log_test, test_write_read)
+{
+  InputLog log;
+  log.m_level = 2;
+  log.m_seed = 12345;
+  log.m_width = 1024;
+  log.m_height = 768;
+
+  InputCommand resize;
+  resize.m_action = InputAction::Resize;
+  resize.m_width = 800;
+  resize.m_height = 600;
+  log.Add(0, resize);
+
+  InputCommand left;
+  left.m_action = InputAction::Left;
+  left.m_isPressed = true;
+  log.Add(10, left);
+
+  left.m_isPressed = false;
+  log.Add(300, left);
+
+  InputCommand fire;
+  log.Add(100000, fire);
+
+  log.m_finalTick = 100001;
+  log.m_finalScore = 400;
+  log.m_finalState = GameState::WIN;
+  log.m_finalHash = 0x0123456789abcdefULL;
+
+  std::string const fileName = "input_log_test.replay";
+  log.Write(fileName);
+
+  InputLog copy = InputLog::Read(fileName);
+  std::remove(fileName.c_str());
+
+  EXPECT_EQ(copy.m_level, 2u);
+  EXPECT_EQ(copy.m_seed, 12345u);
+  EXPECT_EQ(copy.m_width, 1024);
+  EXPECT_EQ(copy.m_height, 768);
+
+  ASSERT_EQ(copy.m_records.size(), 4u);
+  EXPECT_EQ(copy.m_records[0].m_tick, 0u);
+  EXPECT_EQ(copy.m_records[0].m_command.m_action, InputAction::Resize);
+  EXPECT_EQ(copy.m_records[0].m_command.m_width, 800);
+  EXPECT_EQ(copy.m_records[0].m_command.m_height, 600);
+  EXPECT_EQ(copy.m_records[1].m_tick, 10u);
+  EXPECT_EQ(copy.m_records[1].m_command.m_action, InputAction::Left);
+  EXPECT_EQ(copy.m_records[1].m_command.m_isPressed, true);
+  EXPECT_EQ(copy.m_records[2].m_tick, 300u);
+  EXPECT_EQ(copy.m_records[2].m_command.m_isPressed, false);
+  EXPECT_EQ(copy.m_records[3].m_tick, 100000u);
+  EXPECT_EQ(copy.m_records[3].m_command.m_action, InputAction::Fire);
+
+  EXPECT_EQ(copy.m_finalTick, 100001u);
+  EXPECT_EQ(copy.m_finalScore, 400u);
+  EXPECT_EQ(copy.m_finalState, GameState::WIN);
+  EXPECT_EQ(copy.m_finalHash, 0x0123456789abcdefULL);
+}
+
+TEST(input_log_test, test_truncated_file)
+{
+  InputLog log;
+  log.Add(5, InputCommand());
+
+  std::string const fileName = "input_log_test_truncated.replay";
+  log.Write(fileName);
+
+  std::string data;
+  {
+    std::ifstream ifs(fileName, std::ifstream::binary);
+    data.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream ofs(fileName, std::ios::binary | std::ios::trunc);
+    ofs.write(data.data(), data.size() - 3);
+  }
+
+  EXPECT_THROW(InputLog::Read(fileName), ReadFileException);
+  std::remove(fileName.c_str());
+
+  EXPECT_THROW(InputLog::Read("not_existing.replay"), ReadFileException);
+}
@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+#include "job_system.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+TEST(job_system_test, test_dependencies)
+{
+  JobSystem jobs(4);
+
+  for (int run = 0; run < 50; ++run)
+  {
+    std::mutex mutex;
+    std::vector<int> order;
+
+    auto record = [&mutex, &order](int value)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(value);
+    };
+
+    auto a = jobs.Add([&record]() { record(1); });
+    auto b = jobs.Add([&record]() { record(2); });
+    auto c = jobs.Add([&record]() { record(3); }, { a, b });
+    jobs.Add([&record]() { record(4); }, { c });
+
+    jobs.Run();
+
+    ASSERT_EQ(order.size(), 4u);
+    EXPECT_EQ(order[2], 3);
+    EXPECT_EQ(order[3], 4);
+  }
+
+  EXPECT_THROW(jobs.Add([]() {}, { 10 }), std::invalid_argument);
+}
+
+TEST(job_system_test, test_parallel_for)
+{
+  JobSystem jobs(4);
+
+  std::vector<int> values(10000, 0);
+
+  jobs.ParallelFor(values.size(), 100, [&values](size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      values[i]++;
+    }
+  });
+
+  for (auto value : values)
+  {
+    ASSERT_EQ(value, 1);
+  }
+
+  // Ranges inside jobs.
+  std::atomic<size_t> sum(0);
+
+  for (int i = 0; i < 8; ++i)
+  {
+    jobs.Add([&jobs, &sum]()
+    {
+      jobs.ParallelFor(1000, 10, [&sum](size_t begin, size_t end)
+      {
+        sum += end - begin;
+      });
+    });
+  }
+
+  jobs.Run();
+
+  EXPECT_EQ(sum, 8000u);
+}
+
+TEST(job_system_test, test_exception)
+{
+  JobSystem jobs(3);
+
+  std::atomic<bool> isDependentRun(false);
+
+  auto a = jobs.Add([]() { throw std::runtime_error("error"); });
+  jobs.Add([&isDependentRun]() { isDependentRun = true; }, { a });
+
+  EXPECT_THROW(jobs.Run(), std::runtime_error);
+  EXPECT_TRUE(isDependentRun);
+
+  EXPECT_THROW(jobs.ParallelFor(100, 1, [](size_t begin, size_t)
+  {
+    if (begin > 50)
+    {
+      throw std::runtime_error("error");
+    }
+  }), std::runtime_error);
+
+  // The system still works.
+  std::atomic<int> calls(0);
+  jobs.Add([&calls]() { calls++; });
+  jobs.Run();
+  EXPECT_EQ(calls, 1);
+}
@@ -0,0 +1,76 @@
+#include "gtest/gtest.h"
+#include "json_stream.hpp"
+#include "util.hpp"
+#include "except.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+
+std::string const kFileName = "json_stream_test.json";
+
+void WriteText(std::string const & text)
+{
+  std::ofstream ofs(kFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  ofs << text;
+}
+
+} // namespace
+
+TEST(json_stream_test, test_read_level)
+{
+  Json::Value settings;
+  settings["Difficulty"] = 2;
+  settings["Name"] = "Pack with \"quotes\", {braces} and [brackets]";
+
+  // Enough levels to take several blocks of the reader.
+  for (int i = 1; i <= 2000; ++i)
+  {
+    Json::Value & level = settings["Level"][std::to_string(i)];
+    level["AliensNumber"] = i;
+    level["AlienSpeed"] = 100.5;
+    level["Comment"] = "level } \\\" ]";
+    level["Waves"][0] = i;
+    level["Waves"][1]["Enabled"] = true;
+  }
+
+  Util::WriteJson(kFileName, settings);
+
+  for (std::string const level : { "1", "1000", "2000" })
+  {
+    Json::Value const value = JsonStream::Read(kFileName, { "Level", level });
+    EXPECT_EQ(value, settings["Level"][level]);
+  }
+
+  EXPECT_TRUE(JsonStream::Read(kFileName, { "Level", "2001" }).isNull());
+  EXPECT_TRUE(JsonStream::Read(kFileName, { "Difficulty", "1" }).isNull());
+  EXPECT_EQ(JsonStream::Read(kFileName, { "Name" }), settings["Name"]);
+
+  Json::Value const members = JsonStream::ReadMembers(kFileName, { "Level" });
+  EXPECT_EQ(members.size(), 2);
+  EXPECT_EQ(members["Difficulty"], 2);
+  EXPECT_EQ(members["Name"], settings["Name"]);
+
+  std::remove(kFileName.c_str());
+}
+
+TEST(json_stream_test, test_wrong_file)
+{
+  EXPECT_THROW(JsonStream::Read("json_stream_test_missing.json", { "Level" }),
+               ReadFileException);
+
+  // The file ends in the middle of the requested level.
+  WriteText("{ \"Level\" : { \"1\" : { \"AliensNumber\" : 8, ");
+  EXPECT_THROW(JsonStream::Read(kFileName, { "Level", "1" }), ReadFileException);
+
+  // A broken value is found by the parser.
+  WriteText("{ \"Level\" : { \"1\" : { \"AliensNumber\" : 8 : 9 } } }");
+  EXPECT_THROW(JsonStream::Read(kFileName, { "Level", "1" }), ReadFileException);
+
+  WriteText("[ 1, 2 ]");
+  EXPECT_THROW(JsonStream::ReadMembers(kFileName, {}), ReadFileException);
+
+  std::remove(kFileName.c_str());
+}
@@ -58,3 +58,43 @@ TEST(jsoncpp_test, test_read_json_1)
   EXPECT_EQ(settings["Difficulty"], "Easy");
   EXPECT_EQ(settings["Speed"], "Speed 1");
 }
+
+TEST(jsoncpp_test, test_write_json_atomic)
+{
+  std::string file_name = "test_atomic.json";
+
+  Json::Value settings;
+  settings["Difficulty"] = 1;
+  Util::WriteJsonAtomic(file_name, settings);
+
+  settings["Difficulty"] = 2;
+  Util::WriteJsonAtomic(file_name, settings);
+
+  EXPECT_EQ(Util::ReadJson(file_name)["Difficulty"], 2);
+
+  // The temporary file is renamed.
+  std::ifstream temp(file_name + ".tmp");
+  EXPECT_FALSE(temp.is_open());
+
+  std::remove(file_name.c_str());
+}
+
+TEST(jsoncpp_test, test_merge_json)
+{
+  Json::Value base;
+  base["Difficulty"] = 1;
+  base["Speed"] = 1;
+  base["Level"]["1"]["AliensNumber"] = 8;
+  base["Level"]["1"]["AlienSpeed"] = 100;
+
+  Json::Value overlay;
+  overlay["Speed"] = 3;
+  overlay["Level"]["1"]["AlienSpeed"] = 200;
+
+  Util::MergeJson(base, overlay);
+
+  EXPECT_EQ(base["Difficulty"], 1);
+  EXPECT_EQ(base["Speed"], 3);
+  EXPECT_EQ(base["Level"]["1"]["AliensNumber"], 8);
+  EXPECT_EQ(base["Level"]["1"]["AlienSpeed"], 200);
+}
@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+#include "memory_tracker.hpp"
+
+#include <memory>
+#include <vector>
+
+TEST(memory_tracker_test, test_scope)
+{
+  EXPECT_EQ(MemoryTracker::GetTag(), MemoryTag::Other);
+
+  {
+    MemoryScope outer(MemoryTag::Space);
+    EXPECT_EQ(MemoryTracker::GetTag(), MemoryTag::Space);
+
+    {
+      MemoryScope inner(MemoryTag::Logger);
+      EXPECT_EQ(MemoryTracker::GetTag(), MemoryTag::Logger);
+    }
+
+    EXPECT_EQ(MemoryTracker::GetTag(), MemoryTag::Space);
+  }
+
+  EXPECT_EQ(MemoryTracker::GetTag(), MemoryTag::Other);
+  EXPECT_STREQ(MemoryTracker::GetName(MemoryTag::Images), "Images");
+}
+
+TEST(memory_tracker_test, test_allocations)
+{
+  if (!MemoryTracker::IsEnabled())
+  {
+    return;
+  }
+
+  MemoryStats const before = MemoryTracker::GetStats(MemoryTag::Settings);
+
+  std::unique_ptr<std::vector<char>> block;
+  {
+    MemoryScope scope(MemoryTag::Settings);
+    block.reset(new std::vector<char>(1000));
+  }
+
+  MemoryStats const allocated = MemoryTracker::GetStats(MemoryTag::Settings);
+  EXPECT_EQ(allocated.m_allocations - before.m_allocations, 2);
+  EXPECT_EQ(allocated.m_liveBytes - before.m_liveBytes, 1000 + sizeof(std::vector<char>));
+  EXPECT_GE(allocated.m_peakBytes, allocated.m_liveBytes);
+
+  // The block returns to its tag whichever scope releases it.
+  {
+    MemoryScope scope(MemoryTag::Render);
+    block.reset();
+  }
+
+  MemoryStats const released = MemoryTracker::GetStats(MemoryTag::Settings);
+  EXPECT_EQ(released.m_frees - before.m_frees, 2);
+  EXPECT_EQ(released.m_liveBytes, before.m_liveBytes);
+}
+
+TEST(memory_tracker_test, test_external)
+{
+  MemoryStats const before = MemoryTracker::GetStats(MemoryTag::Images);
+
+  MemoryTracker::AddExternal(MemoryTag::Images, 4096);
+  MemoryStats const added = MemoryTracker::GetStats(MemoryTag::Images);
+  MemoryTracker::AddExternal(MemoryTag::Images, -4096);
+  MemoryStats const released = MemoryTracker::GetStats(MemoryTag::Images);
+
+  // Without the tracking build nothing is counted.
+  int64_t const expected = MemoryTracker::IsEnabled() ? 4096 : 0;
+  EXPECT_EQ(added.m_liveBytes - before.m_liveBytes, expected);
+  EXPECT_EQ(released.m_liveBytes, before.m_liveBytes);
+}
@@ -0,0 +1,100 @@
+#include "gtest/gtest.h"
+#include "particle_system.hpp"
+#include "snapshot.hpp"
+
+TEST(particle_system_test, test_emit_and_expire)
+{
+  ParticleSystem particles(8);
+
+  particles.Emit(QVector2D(10.0f, 20.0f), QVector2D(1.0f, 2.0f), 1.0f, TSize(16, 8));
+  particles.Update(0.5f);
+  particles.Emit(QVector2D(30.0f, 40.0f), QVector2D(), 0.25f, TSize(4, 4));
+  EXPECT_EQ(particles.GetCount(), 2);
+
+  std::vector<Particle> copy;
+  particles.CopyTo(copy);
+  ASSERT_EQ(copy.size(), 2);
+
+  EXPECT_EQ(copy[0].m_x, 10.0f);
+  EXPECT_EQ(copy[0].m_vy, 2.0f);
+  EXPECT_EQ(copy[0].m_birth, 0.0f);
+  EXPECT_EQ(copy[0].m_width, 16.0f);
+  EXPECT_EQ(copy[1].m_birth, 0.5f);
+
+  // The second particle expired, but it waits for the first one.
+  particles.Update(0.25f);
+  EXPECT_EQ(particles.GetCount(), 2);
+
+  particles.Update(0.25f);
+  EXPECT_EQ(particles.GetCount(), 0);
+  EXPECT_EQ(particles.GetTime(), 1.0f);
+}
+
+TEST(particle_system_test, test_ring)
+{
+  ParticleSystem particles(4);
+
+  for (int i = 0; i < 6; ++i)
+  {
+    particles.Emit(QVector2D(i, 0.0f), QVector2D(), 1.0f, TSize(1, 1));
+  }
+
+  // The oldest particles gave their places.
+  EXPECT_EQ(particles.GetCount(), 4);
+
+  std::vector<Particle> copy;
+  particles.CopyTo(copy);
+  ASSERT_EQ(copy.size(), 4);
+
+  for (size_t i = 0; i < copy.size(); ++i)
+  {
+    EXPECT_EQ(copy[i].m_x, i + 2.0f);
+  }
+
+  particles.Scale(2.0f, 1.0f);
+  particles.CopyTo(copy);
+  EXPECT_EQ(copy[0].m_x, 4.0f);
+
+  // No buffer, no particles.
+  ParticleSystem empty;
+  empty.Emit(QVector2D(), QVector2D(), 1.0f, TSize(1, 1));
+  EXPECT_EQ(empty.GetCount(), 0);
+}
+
+TEST(particle_system_test, test_save_restore)
+{
+  ParticleSystem particles(4);
+
+  for (int i = 0; i < 5; ++i)
+  {
+    particles.Emit(QVector2D(i, 1.0f), QVector2D(), 1.0f + i, TSize(2, 2));
+  }
+  particles.Update(0.5f);
+
+  Snapshot snapshot;
+  particles.Save(snapshot);
+
+  ParticleSystem restored(4);
+  snapshot.Rewind();
+  restored.Restore(snapshot);
+
+  EXPECT_EQ(restored.GetCount(), 4);
+  EXPECT_EQ(restored.GetTime(), 0.5f);
+
+  std::vector<Particle> expected;
+  std::vector<Particle> copy;
+  particles.CopyTo(expected);
+  restored.CopyTo(copy);
+
+  ASSERT_EQ(copy.size(), expected.size());
+  for (size_t i = 0; i < copy.size(); ++i)
+  {
+    EXPECT_EQ(copy[i].m_x, expected[i].m_x);
+    EXPECT_EQ(copy[i].m_lifetime, expected[i].m_lifetime);
+  }
+
+  // The snapshot doesn't fit a smaller buffer.
+  ParticleSystem small(2);
+  snapshot.Rewind();
+  EXPECT_THROW(small.Restore(snapshot), ReadSnapshotException);
+}
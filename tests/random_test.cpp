@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+#include "random.hpp"
+
+#include <vector>
+
+TEST(random_test, test_reference_sequence)
+{
+  // Reference values of pcg32_random_r from the PCG demo.
+  Pcg32 generator(42u, 54u);
+
+  EXPECT_EQ(generator.Next(), 0xa15c02b7u);
+  EXPECT_EQ(generator.Next(), 0x7b47f409u);
+  EXPECT_EQ(generator.Next(), 0xba1d3330u);
+  EXPECT_EQ(generator.Next(), 0x83d2f293u);
+}
+
+TEST(random_test, test_determinism)
+{
+  Pcg32 generator1(7u, static_cast<uint64_t>(RandomStream::Stars));
+  Pcg32 generator2(7u, static_cast<uint64_t>(RandomStream::Stars));
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    EXPECT_EQ(generator1.Next(), generator2.Next());
+  }
+
+  EXPECT_EQ(generator1, generator2);
+}
+
+TEST(random_test, test_streams)
+{
+  Pcg32 generator1(7u, static_cast<uint64_t>(RandomStream::Stars));
+  Pcg32 generator2(7u, static_cast<uint64_t>(RandomStream::Aliens));
+
+  int equal = 0;
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    if (generator1.Next() == generator2.Next())
+    {
+      equal++;
+    }
+  }
+
+  EXPECT_LT(equal, 5);
+  EXPECT_NE(generator1, generator2);
+}
+
+TEST(random_test, test_range)
+{
+  Pcg32 generator(1u, 1u);
+
+  for (int i = 0; i < 10000; ++i)
+  {
+    float value = generator.NextFloat(-2.0f, 3.0f);
+    EXPECT_GE(value, -2.0f);
+    EXPECT_LT(value, 3.0f);
+  }
+}
+
+TEST(random_test, test_state)
+{
+  Pcg32 generator1(3u, 4u);
+  generator1.Next();
+
+  Pcg32 generator2;
+  generator2.SetState(generator1.GetState(), generator1.GetIncrement());
+
+  EXPECT_EQ(generator1.Next(), generator2.Next());
+}
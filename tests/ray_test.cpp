@@ -1,6 +1,9 @@
 #include "gtest/gtest.h"
 #include "ray.hpp"
 
+#include <cmath>
+#include <vector>
+
 TEST(ray_test, test_construction)
 {
   // Default constructor.
@@ -92,12 +95,6 @@ TEST(ray_test, test_intersection_outside)
   EXPECT_EQ(Ray::checkIntersection(r4, box4), true);
 }
 
-TEST(ray_test, test_radian_to_degree)
-{
-  EXPECT_FLOAT_EQ(Ray::convertRadianToDegrees(Constants::PI), 180);
-  EXPECT_FLOAT_EQ(Ray::convertRadianToDegrees(0.5 * Constants::PI), 90);
-}
-
 TEST(ray_test, test_intersection_inside)
 {
   // Ray origin is inside a box.
@@ -110,8 +107,6 @@ TEST(ray_test, test_intersection_inside)
   EXPECT_EQ(Ray::checkIntersection(r1, box1), true);
 }
 
-// The test contains an error
-// Ray::checkIntersection(r1, box1).
 TEST(ray_test, test_without_intersection_outside)
 {
   // Send a ray to the right.
@@ -151,6 +146,84 @@ TEST(ray_test, test_without_intersection_outside)
   EXPECT_EQ(Ray::checkIntersection(r4, box4), false);
 }
 
+TEST(ray_test, test_intersection_distances)
+{
+  Box2D box = Box2D::createBox(Point2D(2.0f, -1.0f),
+                               Point2D(5.0f, 1.0f));
+  float entry = 0.0f;
+  float exit = 0.0f;
+
+  // Enter through the left side and leave through the right one.
+  EXPECT_EQ(Ray::intersect(Ray(Point2D(0.0f, 0.0f), Point2D(1.0f, 0.0f)), box, entry, exit), true);
+  EXPECT_FLOAT_EQ(entry, 2.0f);
+  EXPECT_FLOAT_EQ(exit, 5.0f);
+
+  // The origin is inside.
+  EXPECT_EQ(Ray::intersect(Ray(Point2D(3.0f, 0.0f), Point2D(-1.0f, 0.0f)), box, entry, exit), true);
+  EXPECT_FLOAT_EQ(entry, 0.0f);
+  EXPECT_FLOAT_EQ(exit, 1.0f);
+
+  // Distances are measured along the normalized direction.
+  EXPECT_EQ(Ray::intersect(Ray(Point2D(0.0f, -2.0f), Point2D(1.0f, 1.0f)), box, entry, exit), true);
+  EXPECT_FLOAT_EQ(entry, 2.0f * std::sqrt(2.0f));
+  EXPECT_FLOAT_EQ(exit, 3.0f * std::sqrt(2.0f));
+
+  // The box is behind the origin.
+  EXPECT_EQ(Ray::intersect(Ray(Point2D(6.0f, 0.0f), Point2D(1.0f, 0.0f)), box, entry, exit), false);
+}
+
+TEST(ray_test, test_intersection_axis_parallel)
+{
+  Box2D box = Box2D::createBox(Point2D(2.0f, -1.0f),
+                               Point2D(5.0f, 1.0f));
+  float entry = 0.0f;
+  float exit = 0.0f;
+
+  // Slide along the top edge.
+  EXPECT_EQ(Ray::intersect(Ray(Point2D(0.0f, 1.0f), Point2D(1.0f, 0.0f)), box, entry, exit), true);
+  EXPECT_FLOAT_EQ(entry, 2.0f);
+
+  // Pass just above the top edge.
+  EXPECT_EQ(Ray::intersect(Ray(Point2D(0.0f, 1.0001f), Point2D(1.0f, 0.0f)), box, entry, exit), false);
+
+  // Go down along the left edge.
+  EXPECT_EQ(Ray::intersect(Ray(Point2D(2.0f, 10.0f), Point2D(0.0f, -1.0f)), box, entry, exit), true);
+  EXPECT_FLOAT_EQ(entry, 9.0f);
+  EXPECT_FLOAT_EQ(exit, 11.0f);
+
+  // A ray without a direction hits only a box around its origin.
+  EXPECT_EQ(Ray::checkIntersection(Ray(), box), false);
+  EXPECT_EQ(Ray::checkIntersection(Ray(Point2D(3.0f, 0.0f), Point2D(0.0f, 0.0f)), box), true);
+}
+
+TEST(ray_test, test_intersection_batch)
+{
+  std::vector<Box2D> boxes = {
+    Box2D::createBox(Point2D(10.0f, -1.0f), Point2D(12.0f, 1.0f)),
+    Box2D::createBox(Point2D(4.0f, 2.0f), Point2D(6.0f, 4.0f)),
+    Box2D::createBox(Point2D(3.0f, -1.0f), Point2D(5.0f, 1.0f)),
+    Box2D::createBox(Point2D(-5.0f, -1.0f), Point2D(-3.0f, 1.0f))
+  };
+  std::vector<float> entries(boxes.size());
+
+  Ray ray(Point2D(0.0f, 0.0f), Point2D(1.0f, 0.0f));
+
+  EXPECT_EQ(Ray::intersect(ray, boxes.data(), boxes.size(), entries.data()), 2);
+  EXPECT_FLOAT_EQ(entries[0], 10.0f);
+  EXPECT_EQ(std::isinf(entries[1]), true);
+  EXPECT_FLOAT_EQ(entries[2], 3.0f);
+  EXPECT_EQ(std::isinf(entries[3]), true);
+
+  // The batch agrees with the single test.
+  for (size_t i = 0; i < boxes.size(); ++i)
+  {
+    EXPECT_EQ(Ray::checkIntersection(ray, boxes[i]), !std::isinf(entries[i]));
+  }
+
+  ray.setDirection(Point2D(0.0f, 1.0f));
+  EXPECT_EQ(Ray::intersect(ray, boxes.data(), boxes.size(), entries.data()), boxes.size());
+}
+
 TEST(ray_test, move)
 {
   Ray r1(Point2D(0.0f, 0.0f),
@@ -189,6 +262,11 @@ TEST(ray_test, normalize)
   direction5 = Ray::normalize(direction5);
   EXPECT_FLOAT_EQ(direction5.x(), 0.0f);
   EXPECT_FLOAT_EQ(direction5.y(), -1.0f);
+
+  Point2D direction6(3.0f, -4.0f);
+  direction6 = Ray::normalize(direction6);
+  EXPECT_FLOAT_EQ(direction6.x(), 0.6f);
+  EXPECT_FLOAT_EQ(direction6.y(), -0.8f);
 }
 
 TEST(ray_test, test_output)
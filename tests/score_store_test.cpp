@@ -0,0 +1,190 @@
+#include "gtest/gtest.h"
+#include "score_store.hpp"
+#include "except.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+
+std::string const kFileName = "score_store_test.log";
+
+ScoreRecord MakeRecord(uint32_t level, uint64_t score, uint64_t time)
+{
+  ScoreRecord record;
+  record.m_level = level;
+  record.m_score = score;
+  record.m_time = time;
+  return record;
+}
+
+size_t GetFileSize(std::string const & fileName)
+{
+  std::ifstream ifs(fileName, std::ifstream::binary | std::ifstream::ate);
+  return static_cast<size_t>(ifs.tellg());
+}
+
+} // namespace
+
+TEST(score_store_test, test_reopen)
+{
+  std::remove(kFileName.c_str());
+
+  {
+    ScoreStore store;
+    store.Open(kFileName);
+    EXPECT_TRUE(store.IsOpen());
+    EXPECT_EQ(store.GetCount(), 0);
+
+    store.Add(MakeRecord(1, 100, 10));
+    store.Add(MakeRecord(2, 300, 20));
+    store.Add(MakeRecord(1, 200, 30));
+  }
+
+  ScoreStore store;
+  store.Open(kFileName);
+
+  EXPECT_EQ(store.GetCount(), 3);
+  EXPECT_EQ(store.GetCorrupted(), 0);
+
+  auto const top = store.GetTop();
+  ASSERT_EQ(top.size(), 3);
+  EXPECT_EQ(top[0].m_score, 300);
+  EXPECT_EQ(top[0].m_level, 2);
+  EXPECT_EQ(top[0].m_time, 20);
+  EXPECT_EQ(top[1].m_score, 200);
+  EXPECT_EQ(top[2].m_score, 100);
+
+  auto const & best = store.GetBestByLevel();
+  ASSERT_EQ(best.size(), 2);
+  EXPECT_EQ(best.at(1).m_score, 200);
+  EXPECT_EQ(best.at(2).m_score, 300);
+
+  std::remove(kFileName.c_str());
+}
+
+TEST(score_store_test, test_top)
+{
+  std::remove(kFileName.c_str());
+
+  ScoreStore store;
+  store.Open(kFileName);
+
+  for (uint64_t i = 0; i < 100; ++i)
+  {
+    // The same scores come twice, the earlier run is better.
+    store.Add(MakeRecord(1, (i * 37) % 50, i));
+  }
+
+  auto const top = store.GetTop();
+  ASSERT_EQ(top.size(), ScoreStore::kTopSize);
+
+  for (size_t i = 0; i < top.size(); ++i)
+  {
+    EXPECT_EQ(top[i].m_score, 49 - i / 2);
+
+    if (i > 0)
+    {
+      EXPECT_TRUE(ScoreStore::IsBetter(top[i - 1], top[i]));
+    }
+  }
+
+  ScoreStore reopened;
+  reopened.Open(kFileName);
+  EXPECT_EQ(reopened.GetCount(), 100);
+
+  auto const reopenedTop = reopened.GetTop();
+  ASSERT_EQ(reopenedTop.size(), top.size());
+
+  for (size_t i = 0; i < top.size(); ++i)
+  {
+    EXPECT_EQ(reopenedTop[i].m_score, top[i].m_score);
+    EXPECT_EQ(reopenedTop[i].m_time, top[i].m_time);
+  }
+
+  std::remove(kFileName.c_str());
+}
+
+TEST(score_store_test, test_torn_write)
+{
+  std::remove(kFileName.c_str());
+
+  ScoreStore store;
+  store.Open(kFileName);
+  store.Add(MakeRecord(1, 100, 10));
+  store.Add(MakeRecord(1, 200, 20));
+
+  size_t const size = GetFileSize(kFileName);
+
+  // A crash in the middle of the next write.
+  {
+    std::ofstream ofs(kFileName, std::ios::out | std::ios::binary | std::ios::app);
+    ofs.write("\x01\x00\x00\x00\x2c\x01", 6);
+  }
+
+  store.Open(kFileName);
+  EXPECT_EQ(store.GetCount(), 2);
+  EXPECT_EQ(GetFileSize(kFileName), size);
+
+  store.Add(MakeRecord(1, 300, 30));
+
+  ScoreStore reopened;
+  reopened.Open(kFileName);
+  EXPECT_EQ(reopened.GetCount(), 3);
+  EXPECT_EQ(reopened.GetCorrupted(), 0);
+  EXPECT_EQ(reopened.GetTop().front().m_score, 300);
+
+  std::remove(kFileName.c_str());
+}
+
+TEST(score_store_test, test_corrupted_record)
+{
+  std::remove(kFileName.c_str());
+
+  ScoreStore store;
+  store.Open(kFileName);
+  store.Add(MakeRecord(1, 100, 10));
+  store.Add(MakeRecord(2, 500, 20));
+  store.Add(MakeRecord(3, 200, 30));
+
+  // Damage the score of the second record.
+  {
+    std::fstream fs(kFileName, std::ios::in | std::ios::out | std::ios::binary);
+    fs.seekp(GetFileSize(kFileName) - 2 * 24 + 4);
+    fs.put('\x7f');
+  }
+
+  ScoreStore reopened;
+  reopened.Open(kFileName);
+  EXPECT_EQ(reopened.GetCount(), 2);
+  EXPECT_EQ(reopened.GetCorrupted(), 1);
+  EXPECT_EQ(reopened.GetTop().front().m_score, 200);
+  EXPECT_EQ(reopened.GetBestByLevel().count(2), 0);
+
+  std::remove(kFileName.c_str());
+}
+
+TEST(score_store_test, test_wrong_file)
+{
+  {
+    std::ofstream ofs(kFileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    ofs << "{ \"Scores\": [] }";
+  }
+
+  ScoreStore store;
+  EXPECT_THROW(store.Open(kFileName), ReadFileException);
+  EXPECT_FALSE(store.IsOpen());
+
+  // Runs aren't appended to the foreign file.
+  EXPECT_THROW(store.Add(MakeRecord(1, 100, 10)), WriteFileException);
+  EXPECT_EQ(store.GetCount(), 0);
+
+  std::ifstream ifs(kFileName, std::ios::in | std::ios::binary);
+  std::string const content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  EXPECT_EQ(content, "{ \"Scores\": [] }");
+
+  std::remove(kFileName.c_str());
+}
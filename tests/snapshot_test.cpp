@@ -0,0 +1,51 @@
+#include "gtest/gtest.h"
+#include "snapshot.hpp"
+#include "except.hpp"
+
+TEST(snapshot_test, test_write_read)
+{
+  Snapshot snapshot;
+  snapshot.Write(42);
+  snapshot.Write(1.5f);
+  snapshot.Write(static_cast<uint64_t>(7));
+  snapshot.Write(true);
+
+  EXPECT_EQ(snapshot.Size(), sizeof(int) + sizeof(float) + sizeof(uint64_t) + sizeof(bool));
+
+  EXPECT_EQ(snapshot.Read<int>(), 42);
+  EXPECT_FLOAT_EQ(snapshot.Read<float>(), 1.5f);
+  EXPECT_EQ(snapshot.Read<uint64_t>(), 7u);
+  EXPECT_EQ(snapshot.Read<bool>(), true);
+
+  EXPECT_THROW(snapshot.Read<int>(), ReadSnapshotException);
+
+  snapshot.Rewind();
+  EXPECT_EQ(snapshot.Read<int>(), 42);
+
+  snapshot.Clear();
+  EXPECT_EQ(snapshot.Size(), 0u);
+  EXPECT_THROW(snapshot.Read<int>(), ReadSnapshotException);
+}
+
+TEST(snapshot_test, test_hash)
+{
+  Snapshot snapshot1;
+  Snapshot snapshot2;
+
+  for (int i = 0; i < 100; ++i)
+  {
+    snapshot1.Write(i);
+    snapshot2.Write(i);
+  }
+
+  EXPECT_EQ(snapshot1.Hash(), snapshot2.Hash());
+
+  snapshot2.Write('x');
+  EXPECT_NE(snapshot1.Hash(), snapshot2.Hash());
+
+  snapshot1.Write('y');
+  EXPECT_NE(snapshot1.Hash(), snapshot2.Hash());
+
+  // Order of combined hashes matters.
+  EXPECT_NE(Snapshot::Combine(1, 2), Snapshot::Combine(2, 1));
+}
@@ -0,0 +1,91 @@
+#include "gtest/gtest.h"
+#include "space.hpp"
+
+TEST(space_test, test_spawn_aliens)
+{
+  Space space;
+  space.AddAlien(std::make_shared<Alien>());
+
+  Alien const prototype(10, QVector2D(), 20, 300, TSize(64, 32), 50);
+
+  space.SpawnAliens(100, prototype, [](size_t i, Alien & alien)
+  {
+    alien.SetFormationOffset(QVector2D(i * 64.0f, 0.0f));
+    alien.SetPosition(QVector2D(i * 64.0f, 600.0f));
+  });
+
+  auto const & aliens = space.GetAliens();
+  ASSERT_EQ(aliens.size(), 101);
+
+  // The new aliens follow the old one in the generator order.
+  size_t i = 0;
+  Alien const * previous = nullptr;
+
+  for (auto it = std::next(aliens.begin()); it != aliens.end(); ++it, ++i)
+  {
+    Alien const & alien = **it;
+
+    EXPECT_EQ(alien.GetHealth(), 300);
+    EXPECT_EQ(alien.GetSize(), TSize(64, 32));
+    EXPECT_EQ(alien.GetPosition(), QVector2D(i * 64.0f, 600.0f));
+    EXPECT_FLOAT_EQ(alien.GetBox().boxMin().x(), i * 64.0f);
+
+    // One block holds all of them.
+    if (previous != nullptr)
+    {
+      EXPECT_EQ(&alien, previous + 1);
+    }
+    previous = &alien;
+  }
+
+  // A removed alien doesn't free the block of the others.
+  std::weak_ptr<Alien> const last = aliens.back();
+
+  std::vector<uint8_t> removed(aliens.size(), 1);
+  removed.back() = 0;
+  space.RemoveAliens(removed);
+
+  ASSERT_EQ(aliens.size(), 1);
+  EXPECT_FALSE(last.expired());
+  EXPECT_EQ(aliens.front()->GetHealth(), 300);
+
+  space.RemoveAliens({ 1 });
+  EXPECT_TRUE(last.expired());
+}
+
+TEST(space_test, test_spawn_nothing)
+{
+  Space space;
+  size_t calls = 0;
+
+  space.SpawnObstacles(0, Obstacle(), [&calls](size_t, Obstacle &) { ++calls; });
+  space.SpawnStars(0, Star(), [&calls](size_t, Star &) { ++calls; });
+
+  EXPECT_EQ(calls, 0);
+  EXPECT_TRUE(space.GetObstacles().empty());
+  EXPECT_TRUE(space.GetStars().empty());
+}
+
+TEST(space_test, test_clear)
+{
+  Space space;
+
+  space.SpawnAliens(4, Alien(), [](size_t, Alien &) {});
+  space.SpawnAlienBullet(Bullet(10, QVector2D(1.0f, 2.0f)));
+  space.SpawnSpaceShipBullet(Bullet(10, QVector2D(3.0f, 4.0f)));
+  space.SetSpaceShip(std::make_shared<SpaceShip>());
+
+  Bullet const * bullet = space.GetAlienBullets().front().get();
+
+  space.Clear();
+
+  EXPECT_TRUE(space.GetAliens().empty());
+  EXPECT_TRUE(space.GetAlienBullets().empty());
+  EXPECT_TRUE(space.GetSpaceShipBullets().empty());
+  EXPECT_NE(space.GetSpaceShip(), nullptr);
+
+  // The next game takes the bullet from the pool.
+  space.SpawnAlienBullet(Bullet(20, QVector2D(5.0f, 6.0f)));
+  EXPECT_EQ(space.GetAlienBullets().front().get(), bullet);
+  EXPECT_EQ(space.GetAlienBullets().front()->GetDamage(), 20);
+}
@@ -0,0 +1,41 @@
+#include "gtest/gtest.h"
+#include "texture_manager.hpp"
+
+TEST(texture_manager_test, test_estimate_bytes)
+{
+  TextureParameters parameters;
+
+  // 64x64, 32x32, ... 1x1.
+  EXPECT_EQ(TextureManager::EstimateBytes(64, 64, parameters), 4 * (4096 + 1024 + 256 + 64 + 16 + 4 + 1));
+
+  // The short side stays at one pixel.
+  EXPECT_EQ(TextureManager::EstimateBytes(4, 1, parameters), 4 * (4 + 2 + 1));
+  EXPECT_EQ(TextureManager::EstimateBytes(1, 1, parameters), 4);
+
+  parameters.m_mipmaps = false;
+  EXPECT_EQ(TextureManager::EstimateBytes(64, 64, parameters), 4 * 4096);
+
+  // A 4x4 block takes 16 bytes, small levels take a whole block.
+  parameters.m_format = TextureFormat::DXT5;
+  EXPECT_EQ(TextureManager::EstimateBytes(64, 64, parameters), 4096);
+
+  parameters.m_mipmaps = true;
+  EXPECT_EQ(TextureManager::EstimateBytes(64, 64, parameters), 4096 + 1024 + 256 + 64 + 16 + 16 + 16);
+
+  // Uncompressed textures need no extension.
+  EXPECT_TRUE(TextureManager::IsSupported(TextureFormat::RGBA8));
+}
+
+TEST(texture_manager_test, test_no_textures)
+{
+  // Textures need a context, so only the empty state is checked here.
+  TextureManager manager(1024);
+  EXPECT_EQ(manager.GetBudget(), 1024);
+  EXPECT_EQ(manager.Get(RenderAsset::Alien), nullptr);
+
+  EXPECT_EQ(TextureManager::GetTotal().m_count, 0);
+  EXPECT_EQ(TextureManager::GetStats(RenderAsset::Star).m_bytes, 0);
+  EXPECT_TRUE(TextureManager::CheckLeaks());
+
+  EXPECT_STREQ(TextureManager::GetName(RenderAsset::AlienBullet), "AlienBullet");
+}
@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+#include "texture_payload.hpp"
+#include "except.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+
+std::vector<unsigned char> MakeImage(int width, int height)
+{
+  std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4);
+
+  // Opaque red left half, transparent right half.
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      unsigned char * pixel = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+      bool const left = x < width / 2;
+      pixel[0] = left ? 255 : 0;
+      pixel[1] = 0;
+      pixel[2] = 0;
+      pixel[3] = left ? 255 : 0;
+    }
+  }
+
+  return pixels;
+}
+
+} // namespace
+
+TEST(texture_payload_test, test_mip_levels)
+{
+  std::vector<unsigned char> const pixels = MakeImage(8, 2);
+
+  TexturePayload const payload = TexturePayload::Build(pixels.data(), 8, 2, true, TextureFormat::RGBA8);
+
+  ASSERT_EQ(payload.m_levels.size(), 4);
+  EXPECT_EQ(payload.m_levels[1].m_width, 4);
+  EXPECT_EQ(payload.m_levels[1].m_height, 1);
+  EXPECT_EQ(payload.m_levels[3].m_width, 1);
+  EXPECT_EQ(payload.m_levels[3].m_height, 1);
+  EXPECT_EQ(payload.GetBytes(), 4 * (16 + 4 + 2 + 1));
+
+  // Transparent pixels don't darken the color, only the alpha drops.
+  unsigned char const * last = payload.m_levels[3].m_data.data();
+  EXPECT_EQ(last[0], 255);
+  EXPECT_EQ(last[3], 128);
+
+  TexturePayload const single = TexturePayload::Build(pixels.data(), 8, 2, false, TextureFormat::RGBA8);
+  ASSERT_EQ(single.m_levels.size(), 1);
+  EXPECT_EQ(single.m_levels[0].m_data, pixels);
+}
+
+TEST(texture_payload_test, test_dxt5)
+{
+  unsigned char block[64];
+  unsigned char out[16];
+
+  for (int i = 0; i < 16; ++i)
+  {
+    bool const first = i % 4 < 2;
+    block[i * 4 + 0] = first ? 255 : 0;
+    block[i * 4 + 1] = 0;
+    block[i * 4 + 2] = first ? 0 : 255;
+    block[i * 4 + 3] = first ? 255 : 0;
+  }
+
+  TexturePayload::EncodeDXT5(block, out);
+
+  // Alpha end points, the first pixels take the opaque one.
+  EXPECT_EQ(out[0], 255);
+  EXPECT_EQ(out[1], 0);
+  EXPECT_EQ(out[2] & 0x3f, 0);
+
+  // The color of the transparent pixels doesn't change the end points.
+  EXPECT_EQ(out[8] | (out[9] << 8), 0xf800);
+  EXPECT_EQ(out[10] | (out[11] << 8), 0xf800);
+
+  std::vector<unsigned char> const pixels = MakeImage(6, 6);
+  TexturePayload const payload = TexturePayload::Build(pixels.data(), 6, 6, true, TextureFormat::DXT5);
+
+  // 6x6, 3x3 and 1x1 are stored in whole blocks.
+  ASSERT_EQ(payload.m_levels.size(), 3);
+  EXPECT_EQ(payload.m_levels[0].m_data.size(), 4 * 16);
+  EXPECT_EQ(payload.m_levels[1].m_data.size(), 16);
+  EXPECT_EQ(payload.m_levels[2].m_data.size(), 16);
+}
+
+TEST(texture_payload_test, test_write_read)
+{
+  std::vector<unsigned char> const pixels = MakeImage(16, 8);
+  TexturePayload const payload = TexturePayload::Build(pixels.data(), 16, 8, true, TextureFormat::DXT5);
+
+  EXPECT_EQ(payload.m_sourceHash, TexturePayload::Hash(pixels.data(), 16, 8));
+  EXPECT_NE(payload.m_sourceHash, TexturePayload::Hash(pixels.data(), 8, 16));
+
+  std::string const fileName = "texture_payload_test.tex";
+  payload.Write(fileName);
+
+  TexturePayload const read = TexturePayload::Read(fileName);
+  EXPECT_EQ(read.m_format, TextureFormat::DXT5);
+  EXPECT_EQ(read.m_sourceHash, payload.m_sourceHash);
+  ASSERT_EQ(read.m_levels.size(), payload.m_levels.size());
+
+  for (size_t i = 0; i < read.m_levels.size(); ++i)
+  {
+    EXPECT_EQ(read.m_levels[i].m_width, payload.m_levels[i].m_width);
+    EXPECT_EQ(read.m_levels[i].m_data, payload.m_levels[i].m_data);
+  }
+
+  // A truncated file isn't accepted.
+  {
+    std::ofstream ofs(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    ofs.write("SITX\x01\x01", 6);
+  }
+  EXPECT_THROW(TexturePayload::Read(fileName), ReadFileException);
+
+  std::remove(fileName.c_str());
+  EXPECT_THROW(TexturePayload::Read(fileName), ReadFileException);
+}
@@ -0,0 +1,58 @@
+#include "gtest/gtest.h"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+TEST(thread_pool_test, test_parallel_for)
+{
+  ThreadPool pool(4);
+  EXPECT_EQ(pool.GetSize(), 4u);
+
+  std::vector<int> values(1000, 0);
+
+  for (int run = 1; run <= 3; ++run)
+  {
+    pool.ParallelFor(values.size(), [&values](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        values[i]++;
+      }
+    });
+
+    for (auto value : values)
+    {
+      ASSERT_EQ(value, run);
+    }
+  }
+
+  // Less items than threads.
+  std::atomic<int> calls(0);
+  pool.ParallelFor(2, [&calls](size_t begin, size_t end)
+  {
+    calls += static_cast<int>(end - begin);
+  });
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(thread_pool_test, test_exception)
+{
+  ThreadPool pool(3);
+
+  EXPECT_THROW(pool.ParallelFor(30, [](size_t begin, size_t)
+  {
+    if (begin > 0)
+    {
+      throw std::runtime_error("error");
+    }
+  }), std::runtime_error);
+
+  // The pool still works.
+  std::atomic<size_t> sum(0);
+  pool.ParallelFor(30, [&sum](size_t begin, size_t end)
+  {
+    sum += end - begin;
+  });
+  EXPECT_EQ(sum, 30u);
+}
@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+#include "triple_buffer.hpp"
+
+#include <thread>
+
+TEST(triple_buffer_test, test_publish)
+{
+  TripleBuffer<int> buffer;
+
+  EXPECT_FALSE(buffer.Update());
+
+  buffer.GetWriteBuffer() = 1;
+  buffer.Publish();
+  buffer.GetWriteBuffer() = 2;
+  buffer.Publish();
+
+  // Only the newest value is seen.
+  EXPECT_TRUE(buffer.Update());
+  EXPECT_EQ(buffer.GetReadBuffer(), 2);
+
+  EXPECT_FALSE(buffer.Update());
+  EXPECT_EQ(buffer.GetReadBuffer(), 2);
+
+  buffer.GetWriteBuffer() = 3;
+  buffer.Publish();
+  EXPECT_TRUE(buffer.Update());
+  EXPECT_EQ(buffer.GetReadBuffer(), 3);
+}
+
+TEST(triple_buffer_test, test_threads)
+{
+  struct Pair
+  {
+    int m_first = 0;
+    int m_second = 0;
+  };
+
+  TripleBuffer<Pair> buffer;
+
+  int constexpr kCount = 100000;
+
+  std::thread producer([&buffer]()
+  {
+    for (int i = 1; i <= kCount; ++i)
+    {
+      buffer.GetWriteBuffer().m_first = i;
+      buffer.GetWriteBuffer().m_second = -i;
+      buffer.Publish();
+    }
+  });
+
+  int last = 0;
+
+  while (last < kCount)
+  {
+    if (buffer.Update())
+    {
+      Pair const & pair = buffer.GetReadBuffer();
+
+      // A value is never torn and never goes back.
+      ASSERT_EQ(pair.m_first, -pair.m_second);
+      ASSERT_GT(pair.m_first, last);
+      last = pair.m_first;
+    }
+  }
+
+  producer.join();
+}
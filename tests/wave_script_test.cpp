@@ -0,0 +1,181 @@
+#include "gtest/gtest.h"
+#include "wave_script.hpp"
+#include "alien.hpp"
+#include "snapshot.hpp"
+
+namespace
+{
+
+GameParameters MakeParameters()
+{
+  GameParameters parameters;
+  parameters.m_alienParameters.m_number = 8;
+  parameters.m_alienParameters.m_rowNumber = 2;
+  parameters.m_alienParameters.m_health = 400;
+  parameters.m_alienParameters.m_frequency = 50;
+  parameters.m_alienParameters.m_size = { 64, 64 };
+  return parameters;
+}
+
+size_t TakeAll(WaveScript & script, std::vector<SpawnEvent> & events)
+{
+  size_t count = 0;
+  SpawnEvent event;
+
+  while (script.Next(event))
+  {
+    events.push_back(event);
+    ++count;
+  }
+
+  return count;
+}
+
+} // namespace
+
+TEST(wave_script_test, test_level_grid)
+{
+  WaveScript script;
+  script.Compile(MakeParameters(), QSize(1024, 768));
+
+  ASSERT_EQ(script.GetEvents().size(), 16);
+  EXPECT_FALSE(script.IsFinished());
+
+  std::vector<SpawnEvent> events;
+  script.Advance(1.0f / 60.0f);
+  EXPECT_EQ(TakeAll(script, events), 16);
+  EXPECT_TRUE(script.IsFinished());
+  EXPECT_FALSE(script.IsEntering());
+
+  // The same places as the grid of the level parameters.
+  EXPECT_EQ(events[0].m_place, QVector2D(0.0f, 600.0f));
+  EXPECT_EQ(events[1].m_place, QVector2D(128.0f, 600.0f));
+  EXPECT_EQ(events[8].m_place, QVector2D(0.0f, 664.0f));
+  EXPECT_EQ(events[15].m_place, QVector2D(896.0f, 664.0f));
+
+  WaveParameters const & wave = script.GetWave(events[0].m_wave);
+  EXPECT_EQ(wave.m_health, 400);
+  EXPECT_EQ(wave.m_frequency, 50);
+}
+
+TEST(wave_script_test, test_waves)
+{
+  GameParameters parameters = MakeParameters();
+
+  WaveParameters late;
+  late.m_time = 2.0f;
+  late.m_columns = 3;
+  late.m_rows = 1;
+  late.m_spacingX = 100.0f;
+  late.m_health = 100;
+  late.m_path = WavePath::Swoop;
+  late.m_pathTime = 1.0f;
+  late.m_entryY = 500.0f;
+
+  WaveParameters first;
+  first.m_interval = 0.5f;
+  first.m_pattern = WavePattern::Wedge;
+  first.m_columns = 5;
+  first.m_rows = 3;
+  first.m_spacingX = 10.0f;
+  first.m_spacingY = 20.0f;
+
+  parameters.m_waves = { late, first };
+
+  WaveScript script;
+  script.Compile(parameters, QSize(1024, 768));
+
+  // The wedge has 5 + 3 + 1 aliens.
+  auto const & events = script.GetEvents();
+  ASSERT_EQ(events.size(), 12);
+
+  for (size_t i = 1; i < events.size(); ++i)
+  {
+    EXPECT_LE(events[i - 1].m_time, events[i].m_time);
+  }
+
+  // Events of the same time keep the order of the waves.
+  EXPECT_EQ(script.GetWave(events[4].m_wave).m_health, 100);
+  EXPECT_EQ(events[7].m_place, QVector2D(40.0f, 0.0f));
+  EXPECT_EQ(events[8].m_place, QVector2D(10.0f, 20.0f));
+  EXPECT_EQ(events[11].m_place, QVector2D(20.0f, 40.0f));
+
+  // One alien of the wedge comes every half a second.
+  std::vector<SpawnEvent> taken;
+  script.Advance(0.25f);
+  EXPECT_EQ(TakeAll(script, taken), 1);
+  script.Advance(0.5f);
+  EXPECT_EQ(TakeAll(script, taken), 1);
+  EXPECT_FALSE(script.IsEntering());
+
+  // The wedge aliens which are due come with the whole late wave.
+  script.Advance(1.25f);
+  EXPECT_EQ(TakeAll(script, taken), 6);
+  EXPECT_TRUE(script.IsEntering());
+
+  SpawnEvent const & swoop = taken[taken.size() - 2];
+  EXPECT_EQ(swoop.m_place, QVector2D(200.0f, 0.0f));
+
+  QVector2D start;
+  QVector2D control;
+  script.GetEntryPath(swoop, start, control);
+  EXPECT_EQ(start, QVector2D(200.0f, 500.0f));
+  EXPECT_EQ(control, QVector2D(200.0f, 0.0f));
+
+  script.Advance(1.0f);
+  EXPECT_FALSE(script.IsEntering());
+
+  script.Finish();
+  EXPECT_TRUE(script.IsFinished());
+  EXPECT_FALSE(script.Next(taken.back()));
+}
+
+TEST(wave_script_test, test_scale_and_restore)
+{
+  GameParameters const parameters = MakeParameters();
+
+  WaveScript script;
+  script.Compile(parameters, QSize(1024, 768));
+  script.Advance(0.5f);
+  script.Scale(0.5f, 2.0f);
+
+  Snapshot snapshot;
+  script.Save(snapshot);
+
+  SpawnEvent event;
+  ASSERT_TRUE(script.Next(event));
+  EXPECT_EQ(event.m_place, QVector2D(0.0f, 1200.0f));
+
+  // A script which wasn't compiled is compiled by the restore.
+  WaveScript restored;
+  snapshot.Rewind();
+  restored.Restore(snapshot, parameters);
+
+  EXPECT_EQ(restored.GetEvents().size(), 16);
+  EXPECT_EQ(restored.GetTime(), 0.5f);
+
+  SpawnEvent restoredEvent;
+  ASSERT_TRUE(restored.Next(restoredEvent));
+  EXPECT_EQ(restoredEvent.m_place, event.m_place);
+}
+
+TEST(wave_script_test, test_entry_path)
+{
+  Alien alien;
+  alien.SetFormationOffset(QVector2D(100.0f, 100.0f));
+  alien.SetEntryPath(QVector2D(100.0f, 500.0f), QVector2D(100.0f, 100.0f), 1.0f);
+
+  EXPECT_EQ(alien.GetFormationOffset(), QVector2D(100.0f, 500.0f));
+
+  alien.UpdateEntryPath(0.5f);
+  EXPECT_FLOAT_EQ(alien.GetFormationOffset().x(), 100.0f);
+  EXPECT_FLOAT_EQ(alien.GetFormationOffset().y(), 200.0f);
+
+  alien.UpdateEntryPath(0.75f);
+  EXPECT_EQ(alien.GetFormationOffset(), QVector2D(100.0f, 100.0f));
+
+  // The place in the formation doesn't change after the path.
+  alien.SetFormationOffset(QVector2D(50.0f, 50.0f));
+  alien.UpdateEntryPath(0.5f);
+  EXPECT_EQ(alien.GetFormationOffset(), QVector2D(50.0f, 50.0f));
+}
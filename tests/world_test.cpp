@@ -0,0 +1,249 @@
+#include "gtest/gtest.h"
+#include "world.hpp"
+#include "batch_environment.hpp"
+#include "settings.hpp"
+#include "random.hpp"
+
+#include <algorithm>
+
+namespace
+{
+
+///
+/// A small level with fast bullets and weak aliens,
+/// so aliens and obstacles are hit, damaged and removed.
+///
+GameContext MakeContext()
+{
+  GameContext context;
+  context.m_fieldSize = QSize(1024, 768);
+
+  GameParameters & parameters = context.m_parameters;
+  parameters.m_mainParameters.m_seed = 7;
+
+  parameters.m_starParameters.m_number = 100;
+  parameters.m_starParameters.m_size = { 16, 16 };
+
+  parameters.m_explosionParameters.m_size = { 16, 16 };
+  parameters.m_explosionParameters.m_sizeBig = { 64, 64 };
+  parameters.m_explosionParameters.m_lifetime = 30;
+  parameters.m_explosionParameters.m_lifetimeBig = 60;
+  parameters.m_explosionParameters.m_particles = 8;
+  parameters.m_explosionParameters.m_speed = 120.0f;
+
+  parameters.m_alienParameters.m_number = 60;
+  parameters.m_alienParameters.m_rowNumber = 6;
+  parameters.m_alienParameters.m_speed = 100;
+  parameters.m_alienParameters.m_rate = 200;
+  parameters.m_alienParameters.m_health = 30;
+  parameters.m_alienParameters.m_size = { 20, 20 };
+  parameters.m_alienParameters.m_frequency = 10;
+  parameters.m_alienParameters.m_score = 10;
+
+  parameters.m_bulletParameters.m_damage = 10;
+  parameters.m_bulletParameters.m_size = { 8, 8 };
+
+  parameters.m_spaceShipParameters.m_health = 100000;
+  parameters.m_spaceShipParameters.m_rate = 400;
+  parameters.m_spaceShipParameters.m_speed = 300;
+  parameters.m_spaceShipParameters.m_size = { 40, 40 };
+
+  parameters.m_obstacleParameters.m_number = 8;
+  parameters.m_obstacleParameters.m_health = 50;
+  parameters.m_obstacleParameters.m_size = { 60, 30 };
+  parameters.m_obstacleParameters.m_score = 5;
+
+  return context;
+}
+
+///
+/// Apply the commands of the steps [begin, end) and tick the world.
+/// The space ship fires all the time and moves from side to side.
+///
+void Play(World & world, int begin, int end)
+{
+  for (int tick = begin; tick < end; ++tick)
+  {
+    InputCommand command;
+    command.m_isPressed = true;
+
+    if (tick % 2 == 0)
+    {
+      command.m_action = InputAction::Fire;
+      for (int i = 0; i < 5; ++i)
+      {
+        world.Apply(command);
+      }
+    }
+
+    command.m_action = (tick / 60) % 2 ? InputAction::Left : InputAction::Right;
+    world.Apply(command);
+
+    world.Tick(World::kFixedTimeStep);
+  }
+}
+
+} // namespace
+
+TEST(world_test, test_save_restore)
+{
+  GameContext const context = MakeContext();
+
+  World world(context);
+  world.Initialize();
+  Play(world, 0, 300);
+
+  Snapshot snapshot;
+  world.Save(snapshot);
+
+  World restored(context);
+  restored.Initialize();
+  restored.Restore(snapshot);
+
+  EXPECT_EQ(restored.Hash(), world.Hash());
+  EXPECT_EQ(restored.GetHistoryHash(), world.GetHistoryHash());
+  EXPECT_EQ(restored.GetTick(), 300);
+
+  // Both games go on in the same way.
+  Play(world, 300, 600);
+  Play(restored, 300, 600);
+
+  EXPECT_EQ(restored.Hash(), world.Hash());
+  EXPECT_EQ(restored.GetHistoryHash(), world.GetHistoryHash());
+  EXPECT_EQ(restored.GetScore(), world.GetScore());
+}
+
+TEST(world_test, test_entity_hashes)
+{
+  GameContext const context = MakeContext();
+
+  World world(context);
+  world.Initialize();
+
+  // Restore() sums the hashes of the lists from scratch, so the sums
+  // kept by the steps must give the same hash after every step.
+  World restored(context);
+  restored.Initialize();
+
+  Snapshot snapshot;
+
+  for (int tick = 0; tick < 900; ++tick)
+  {
+    if (tick == 450)
+    {
+      InputCommand resize;
+      resize.m_action = InputAction::Resize;
+      resize.m_width = 800;
+      resize.m_height = 600;
+      world.Apply(resize);
+    }
+
+    Play(world, tick, tick + 1);
+
+    snapshot.Clear();
+    world.Save(snapshot);
+    restored.Restore(snapshot);
+
+    ASSERT_EQ(restored.Hash(), world.Hash()) << "tick " << tick;
+  }
+
+  // Aliens and obstacles were damaged and removed on the way,
+  // the score grows only when they are destroyed.
+  EXPECT_GT(world.GetScore(), 0);
+  EXPECT_LT(world.GetSpace()->GetObstacles().size(), 8);
+}
+
+TEST(world_test, test_job_system)
+{
+  GameContext context = MakeContext();
+
+  // Long lists are also split into chunks of the parallel loops.
+  context.m_parameters.m_alienParameters.m_rowNumber = 12;
+
+  World serial(context);
+  serial.Initialize();
+  serial.SetJobSystem(nullptr);
+  Play(serial, 0, 600);
+
+  // The stages of the parallel tick keep the serial order of every piece of the state.
+  JobSystem jobSystem(4);
+
+  World parallel(context);
+  parallel.Initialize();
+  parallel.SetJobSystem(&jobSystem);
+  Play(parallel, 0, 600);
+
+  EXPECT_GT(serial.GetSpace()->GetAliens().size(), 512);
+  EXPECT_EQ(parallel.GetHistoryHash(), serial.GetHistoryHash());
+  EXPECT_EQ(parallel.GetScore(), serial.GetScore());
+}
+
+TEST(world_test, test_reset)
+{
+  GameContext const context = MakeContext();
+
+  World world(context);
+  world.Initialize(3);
+  Play(world, 0, 300);
+  world.Reset(11);
+
+  World fresh(context);
+  fresh.Initialize(11);
+
+  // The whole stored state is the same.
+  Snapshot snapshot;
+  world.Save(snapshot);
+  Snapshot freshSnapshot;
+  fresh.Save(freshSnapshot);
+
+  EXPECT_EQ(snapshot.Hash(), freshSnapshot.Hash());
+  EXPECT_EQ(world.Hash(), fresh.Hash());
+  EXPECT_EQ(world.GetTick(), 0);
+  EXPECT_EQ(world.GetScore(), 0);
+
+  Play(world, 0, 600);
+  Play(fresh, 0, 600);
+
+  EXPECT_EQ(world.GetHistoryHash(), fresh.GetHistoryHash());
+}
+
+TEST(world_test, test_batch_threads)
+{
+  // The space ship is weak, so episodes end and games are reset.
+  GameParameters & settings = Settings::Instance();
+  settings = MakeContext().m_parameters;
+  settings.m_spaceShipParameters.m_health = 30;
+
+  size_t const instances = 16;
+
+  BatchEnvironment one(instances, 1, 5, 1);
+  BatchEnvironment many(instances, 1, 5, 4);
+
+  Pcg32 random;
+  random.Seed(5, 0);
+
+  std::vector<BatchAction> actions(instances);
+  size_t dones = 0;
+
+  for (int step = 0; step < 300; ++step)
+  {
+    for (auto & action : actions)
+    {
+      action = static_cast<BatchAction>(random.Next() % static_cast<uint32_t>(BatchAction::Count));
+    }
+
+    one.Step(actions.data());
+    many.Step(actions.data());
+
+    ASSERT_TRUE(std::equal(one.GetObservations(),
+                           one.GetObservations() + instances * BatchEnvironment::kObservationSize,
+                           many.GetObservations())) << "step " << step;
+    ASSERT_TRUE(std::equal(one.GetRewards(), one.GetRewards() + instances, many.GetRewards()));
+    ASSERT_TRUE(std::equal(one.GetDones(), one.GetDones() + instances, many.GetDones()));
+
+    dones += std::count(one.GetDones(), one.GetDones() + instances, 1);
+  }
+
+  EXPECT_GT(dones, 0);
+  EXPECT_EQ(one.GetTotalTicks(), many.GetTotalTicks());
+}